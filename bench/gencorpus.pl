@@ -0,0 +1,249 @@
+#!/usr/bin/perl -w
+
+###############################################################################
+# Generates a synthetic source tree for benchmarking krazy.                   #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+# The tree holds C++ sources and headers made from the test data files found
+# in testdata/plugins and testdata/extras, along with .desktop, .kcfg, .ui,
+# .json, .svg and CMakeLists.txt files made from templates.
+# The same options always generate the same tree, byte for byte.
+
+# Program options:
+#   --help:          print a help message and exit
+#   --files <N>:     the number of files to generate (default 2000)
+#   --lines <N>:     the approximate number of lines of each file (default 200)
+#   --seed <N>:      the seed of the pseudo-random choices (default 1)
+#   --testdata <dir>: the test data directory (default ../testdata)
+# Takes one command line argument: the directory to create.
+
+use warnings;
+use strict;
+use Getopt::Long;
+use File::Find;
+use File::Path qw(make_path remove_tree);
+use FindBin qw($Bin);
+
+my ($help)     = '';
+my ($files)    = 2000;
+my ($lines)    = 200;
+my ($seed)     = 1;
+my ($testdata) = "$Bin/../testdata";
+
+exit 1
+  if (
+  !GetOptions(
+    'help'       => \$help,
+    'files=i'    => \$files,
+    'lines=i'    => \$lines,
+    'seed=i'     => \$seed,
+    'testdata=s' => \$testdata,
+  )
+  );
+
+if ($help || $#ARGV != 0) {
+  print "Usage: gencorpus.pl [--files N] [--lines N] [--seed N] [--testdata dir] <dir>\n";
+  exit 0;
+}
+my ($top) = $ARGV[0];
+
+# a portable pseudo-random number generator, so the tree is the same everywhere
+my ($state) = $seed;
+
+sub rnd
+{
+  my ($n) = @_;
+  $state = ($state * 1103515245 + 12345) % 2147483648;
+  return int(($state / 2147483648) * $n);
+}
+
+sub pick
+{
+  return $_[&rnd(scalar(@_))];
+}
+
+# the C++ seed content
+my (@sources, @headers);
+find(
+  sub {
+    return if (!-f $_);
+    push(@sources, $File::Find::name) if (m/\.(?:cpp|cc|c)$/);
+    push(@headers, $File::Find::name) if (m/\.(?:h|hpp)$/);
+  },
+  "$testdata/plugins",
+  "$testdata/extras"
+);
+@sources = sort @sources;
+@headers = sort @headers;
+die "No C++ seed files found in $testdata\n" if ($#sources < 0 || $#headers < 0);
+
+sub slurp
+{
+  my ($f) = @_;
+  open(my $fh, '<:raw', $f) or die "Cannot read $f: $!\n";
+  my ($s) = do {local $/; <$fh>};
+  close($fh);
+  $s = "" if (!defined($s));
+  $s .= "\n" if ($s ne "" && $s !~ m/\n$/);
+  return $s;
+}
+my (%seedText);
+
+# return C++ content of about $lines lines, made of seed files
+sub cppContent
+{
+  my (@seeds) = @_;
+  my ($text) = "";
+  while (($text =~ tr/\n//) < $lines) {
+    my ($f) = &pick(@seeds);
+    $seedText{$f} = &slurp($f) if (!defined($seedText{$f}));
+    $text .= $seedText{$f};
+  }
+  return $text;
+}
+
+sub desktopContent
+{
+  my ($n) = @_;
+  my ($text) = "[Desktop Entry]\nType=Application\nName=Corpus $n\nExec=corpus$n %U\nIcon=corpus\n";
+  for (my $i = 0 ; $i < $lines / 4 ; $i++) {
+    my ($lang) = &pick("de", "fr", "es", "it", "nl", "pt_BR", "sv", "uk");
+    $text .= "Name[$lang]=Corpus $n $i\nComment[$lang]=A test program number $i\n";
+  }
+  return $text . "Categories=Qt;KDE;Utility;\n";
+}
+
+sub kcfgContent
+{
+  my ($n)    = @_;
+  my ($text) = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    . "<kcfg xmlns=\"http://www.kde.org/standards/kcfg/1.0\"\n"
+    . "      xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"\n"
+    . "      xsi:schemaLocation=\"http://www.kde.org/standards/kcfg/1.0 http://www.kde.org/standards/kcfg/1.0/kcfg.xsd\">\n"
+    . "  <kcfgfile name=\"corpus${n}rc\"/>\n  <group name=\"General\">\n";
+  for (my $i = 0 ; $i < $lines / 4 ; $i++) {
+    my ($type) = &pick("Bool", "Int", "String");
+    my ($default) = $type eq "Bool" ? "true" : $type eq "Int" ? $i : "value$i";
+    $text .= "    <entry name=\"Setting$i\" type=\"$type\">\n      <default>$default</default>\n    </entry>\n";
+  }
+  return $text . "  </group>\n</kcfg>\n";
+}
+
+sub uiContent
+{
+  my ($n)    = @_;
+  my ($text) = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ui version=\"4.0\">\n <class>Corpus$n</class>\n"
+    . " <widget class=\"QWidget\" name=\"Corpus$n\">\n  <layout class=\"QVBoxLayout\" name=\"layout\">\n";
+  for (my $i = 0 ; $i < $lines / 8 ; $i++) {
+    my ($class) = &pick("QLabel", "QPushButton", "QCheckBox");
+    $text .= "   <item>\n    <widget class=\"$class\" name=\"widget$i\">\n     <property name=\"text\">\n"
+      . "      <string>Item &amp;$i</string>\n     </property>\n    </widget>\n   </item>\n";
+  }
+  return $text . "  </layout>\n </widget>\n <resources/>\n <connections/>\n</ui>\n";
+}
+
+sub jsonContent
+{
+  my ($n) = @_;
+  my (@entries) = ();
+  for (my $i = 0 ; $i < $lines / 4 ; $i++) {
+    push(@entries, "        {\n            \"Name\": \"entry $i\",\n            \"Value\": " . &rnd(1000) . "\n        }");
+  }
+  return "{\n    \"KPlugin\": {\n        \"Id\": \"corpus$n\",\n        \"Name\": \"Corpus $n\"\n    },\n"
+    . "    \"Entries\": [\n"
+    . join(",\n", @entries)
+    . "\n    ]\n}\n";
+}
+
+sub svgContent
+{
+  my ($n) = @_;
+  my ($text) = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    . "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"256\" height=\"256\" viewBox=\"0 0 256 256\">\n"
+    . "  <title>corpus $n</title>\n";
+  for (my $i = 0 ; $i < $lines ; $i++) {
+    $text .=
+        "  <rect x=\"" . &rnd(256)
+      . "\" y=\"" . &rnd(256)
+      . "\" width=\"" . &rnd(64)
+      . "\" height=\"" . &rnd(64)
+      . "\" fill=\"#" . sprintf("%06x", &rnd(16777216))
+      . "\"/>\n";
+  }
+  return $text . "</svg>\n";
+}
+
+sub writeFile
+{
+  my ($f, $text) = @_;
+  open(my $fh, '>:raw', $f) or die "Cannot write $f: $!\n";
+  print $fh $text;
+  close($fh);
+}
+
+# the file types, with their weights out of 100
+my (@kinds) = (
+  ['cpp',     40],
+  ['h',       36],
+  ['desktop', 4],
+  ['kcfg',    4],
+  ['ui',      4],
+  ['json',    4],
+  ['svg',     4],
+  ['cmake',   4],
+);
+
+remove_tree($top) if (-d $top);
+my ($dir) = '';
+my (@dirFiles) = ();
+my (%counts);
+for (my $n = 0 ; $n < $files ; $n++) {
+
+  # 25 files per directory
+  if ($n % 25 == 0) {
+    $dir = sprintf("%s/src/module%03d", $top, $n / 25);
+    make_path($dir);
+    @dirFiles = ();
+  }
+
+  my ($r) = &rnd(100);
+  my ($kind);
+  foreach my ($k) (@kinds) {
+    $kind = $k->[0];
+    last if ($r < $k->[1]);
+    $r -= $k->[1];
+  }
+  my ($name) = sprintf("file%05d", $n);
+  if ($kind eq "cpp") {
+    &writeFile("$dir/$name.cpp", &cppContent(@sources));
+    push(@dirFiles, "$name.cpp");
+  } elsif ($kind eq "h") {
+    &writeFile("$dir/$name.h", &cppContent(@headers));
+  } elsif ($kind eq "desktop") {
+    &writeFile("$dir/$name.desktop", &desktopContent($n));
+  } elsif ($kind eq "kcfg") {
+    &writeFile("$dir/$name.kcfg", &kcfgContent($n));
+  } elsif ($kind eq "ui") {
+    &writeFile("$dir/$name.ui", &uiContent($n));
+  } elsif ($kind eq "json") {
+    &writeFile("$dir/$name.json", &jsonContent($n));
+  } elsif ($kind eq "svg") {
+    &writeFile("$dir/$name.svg", &svgContent($n));
+  } else {
+    my ($sub) = "$dir/$name";
+    make_path($sub);
+    &writeFile("$sub/CMakeLists.txt",
+      "add_library($name STATIC)\ntarget_sources($name PRIVATE\n" . join("", map {"  ../$_\n"} @dirFiles) . ")\n");
+  }
+  $counts{$kind}++;
+}
+
+# the top-level project files
+&writeFile("$top/CMakeLists.txt", "cmake_minimum_required(VERSION 3.16)\nproject(corpus)\n");
+
+# the parameters of the tree, for the benchmark reports
+&writeFile("$top/CORPUS", "files=$files lines=$lines seed=$seed\n");
+
+print "Generated $files files in $top: " . join(", ", map {"$counts{$_} $_"} sort keys %counts) . "\n";
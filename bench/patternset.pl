@@ -0,0 +1,172 @@
+#!/usr/bin/perl -w
+
+###############################################################################
+# Times the pattern sets against the chains of matches they replace.          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+# Matches generated lines against a set of patterns, first the way the
+# checkers did before Krazy::PatternSet (a chain of comparisons or of
+# separate regular expression matches), then with a Krazy::PatternSet, and
+# prints the time taken by each, the speedup and whether the results are the
+# same.  The sets are:
+#   exact:   the Qt modules of the includes checker, as a chain of 'eq'
+#   literal: the generated-file markers of the copyright checker, as a chain
+#            of m//
+#   regex:   the businesses of the copyright checker, as a chain of m//i
+#   search:  the non-copyright patterns of the copyright checker, as
+#            linesSearchInFile() tried them, with m/$l/i in a loop over the
+#            patterns for each line
+
+# Program options:
+#   --help:          print a help message and exit
+#   --lines <N>:     the number of lines matched (default 100000)
+#   --runs <N>:      run each test N times, keeping the fastest run (default 3)
+
+use warnings;
+use strict;
+use Getopt::Long;
+use Time::HiRes qw(time);
+use FindBin qw($Bin);
+use lib "$Bin/../lib";
+use Krazy::PatternSet;
+
+my ($help)  = '';
+my ($lines) = 100000;
+my ($runs)  = 3;
+
+exit 1
+  if (
+  !GetOptions(
+    'help'    => \$help,
+    'lines=i' => \$lines,
+    'runs=i'  => \$runs,
+  )
+  );
+
+if ($help || $#ARGV >= 0) {
+  print "Usage: patternset.pl [--lines N] [--runs N]\n";
+  exit 0;
+}
+$runs = 1 if ($runs < 1);
+
+# the Qt modules, as listed in the includes checker
+my ($includes) = join("", `cat '$Bin/../plugins/c++/includes'`);
+die "Cannot read the Qt modules of the includes checker\n"
+  if ($includes !~ m/\$QtModules = Krazy::PatternSet->new\(\s*\[\s*qw\(([^)]*)\)/s);
+my (@modules) = split(" ", $1);
+
+my (@markers) = (
+  "generated from",
+  "generated by",
+  "uic-generated",
+  "changes made in this file will be lost",
+  "produced by gperf",
+  "This file is automatically generated",
+  "created by dcopidl2cpp",
+);
+
+my (@businesses) = (
+  'Datakonsult',
+  'KDAB',
+  'Kitware, inc',
+  'Apple Computer',
+  'Apple\s*,?\s*Inc',
+  'Free Software Foundation',
+  '(World Wide Web Consortium|W3C)',
+  'Aladdin Enterprises',
+  'SUSE Linux',
+  'Open Group',
+  'Netscape',
+  'NLNet Labs',
+  'Nokia',
+  'Novell, Inc',
+  'Tridia Corporation',
+  'AT\&T Laboratories',
+  'X Consortium',
+  'heXoNet Support',
+  'Trolltech AS',
+  'Lucent Tech',
+  'University of California',
+  'Sendmail\, INC',
+  'Sun Microsystems',
+  'Network Computing Devices',
+  'MP3tunes, LLC',
+  '4Front Technologies',
+  'Critical Path',
+  'Ximian',
+  'Intevation GmbH',
+  'ScalingWeb',
+  'Red Hat',
+  'Digia Plc',
+  'Canonical',
+  'Fastmail Pty',
+  'Hiram Clawson',
+);
+
+my (@patterns) = (
+  '[[:alnum:]]copyright',
+  ' copyrighted',
+  ' copyright holder',
+  ' above copyright',
+  ' copyright notice',
+  ' infringement of copyright',
+  ' disclaims copyright',
+  ' the copyright',
+  ' copyrights',
+  ' AUTHORS OR COPYRIGHT',
+  'Copyright\.html',
+);
+
+# the inputs: mostly lines matching no member, as in real files
+my (@names) = map {($_ % 20 == 0) ? $modules[$_ % @modules] : ("QtFoo" . $_ % 50)} (0 .. $lines - 1);
+my (@text)  = map {
+  ($_ % 20 == 0)
+    ? " * You should have received a copy of the GNU General Public License; the copyright holder $_\n"
+    : "  int value$_ = compute(m_count, QStringLiteral(\"copy\")); // the right value\n"
+} (0 .. $lines - 1);
+
+# the chains, as the checkers wrote them
+my ($eqChain)  = eval 'sub {my ($p) = @_; return (' . join(" || ", map {"\$p eq \"$_\""} @modules) . ') ? 1 : 0;}';   ## no critic
+my ($litChain) = eval 'sub {my ($s) = @_; return (' . join(" || ", map {"\$s =~ m/$_/"} @markers) . ') ? 1 : 0;}';   ## no critic
+my ($reChain)  = eval 'sub {my ($s) = @_; return (' . join(" || ", map {"\$s =~ m/$_/i"} @businesses) . ') ? 1 : 0;}';   ## no critic
+my ($loop) = sub {
+  my ($s) = @_;
+  for my ($l) (@patterns) {
+    return 1 if ($s =~ m/$l/i);
+  }
+  return 0;
+};
+
+my (@tests) = (
+  ['exact',   \@names, $eqChain,  Krazy::PatternSet->new(\@modules,    'exact'   => 1)],
+  ['literal', \@text,  $litChain, Krazy::PatternSet->new(\@markers,    'literal' => 1)],
+  ['regex',   \@text,  $reChain,  Krazy::PatternSet->new(\@businesses, 'icase'   => 1)],
+  ['search',  \@text,  $loop,     Krazy::PatternSet->new(\@patterns,   'icase'   => 1)],
+);
+
+# the fastest of the runs of $code, in seconds, and its last result
+sub timeIt
+{
+  my ($code, @args) = @_;
+  my ($best, @result);
+  for (my $i = 0 ; $i < $runs ; $i++) {
+    my ($start) = time();
+    @result = &{$code}(@args);
+    my ($t) = time() - $start;
+    $best = $t if (!defined($best) || $t < $best);
+  }
+  return ($best, @result);
+}
+
+printf("Krazy::PatternSet timings, %d lines, best of %d run%s\n", $lines, $runs, $runs > 1 ? "s" : "");
+printf("%-8s %7s %10s %10s %8s  %s\n", "set", "members", "chain(ms)", "set(ms)", "speedup", "results");
+foreach my ($test) (@tests) {
+  my ($name, $in, $chain, $set) = @{$test};
+  my ($ct, @cout) = &timeIt(sub {return map {&{$chain}($_)} @{$in};});
+  my ($st, @sout) = &timeIt(sub {return map {$set->test($_)} @{$in};});
+  my ($same) = (join("", @cout) eq join("", @sout)) ? "same" : "differ";
+  printf("%-8s %7d %10.1f %10.1f %7.1fx  %s\n",
+    $name, scalar($set->members()), $ct * 1000, $st * 1000, $st > 0 ? $ct / $st : 0, $same);
+}
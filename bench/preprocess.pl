@@ -0,0 +1,115 @@
+#!/usr/bin/perl -w
+
+###############################################################################
+# Times the source preprocessing functions of the checkers.                   #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+# Runs the functions of Krazy::PreProcess that the C++ checkers call on every
+# file on a generated, well-documented C++ header of several sizes, and prints
+# the time taken and the lines processed per second.
+# With --rev, the Krazy::PreProcess of that git revision is timed on the same
+# input too, and the speedup and whether the outputs are the same are shown.
+
+# Program options:
+#   --help:          print a help message and exit
+#   --sizes <N[,N1,...,Nn]>: the input sizes, in lines (default 1000,10000,100000)
+#   --runs <N>:      run each function N times, keeping the fastest run (default 3)
+#   --rev <rev>:     compare with the Krazy::PreProcess of this git revision
+
+use warnings;
+use strict;
+use Getopt::Long;
+use Time::HiRes qw(time);
+use FindBin qw($Bin);
+use lib "$Bin/../lib";
+use Krazy::PreProcess;
+
+my ($help)  = '';
+my ($sizes) = "1000,10000,100000";
+my ($runs)  = 3;
+my ($rev)   = '';
+
+exit 1
+  if (
+  !GetOptions(
+    'help'    => \$help,
+    'sizes=s' => \$sizes,
+    'runs=i'  => \$runs,
+    'rev=s'   => \$rev,
+  )
+  );
+
+if ($help || $#ARGV >= 0) {
+  print "Usage: preprocess.pl [--sizes N,...] [--runs N] [--rev revision]\n";
+  exit 0;
+}
+$runs = 1 if ($runs < 1);
+
+# the functions timed, with a call running each of them on the lines of a file
+my (@functions) = (
+  ['RemoveCommentsC',    sub {my ($pkg, @l) = @_; return &{\&{"${pkg}::RemoveCommentsC"}}(@l);}],
+  ['RemoveIfZeroBlockC', sub {my ($pkg, @l) = @_; return &{\&{"${pkg}::RemoveIfZeroBlockC"}}(@l);}],
+  ['RemoveCondBlockC',   sub {my ($pkg, @l) = @_; return &{\&{"${pkg}::RemoveCondBlockC"}}("normalize", @l);}],
+);
+
+# load the Krazy::PreProcess of the revision into a package of its own
+my ($revPkg) = '';
+if ($rev) {
+  my ($code) = join("", `git -C '$Bin' show '$rev:lib/Krazy/PreProcess.pm' 2>/dev/null`);
+  die "Cannot find lib/Krazy/PreProcess.pm in revision $rev\n" if (!$code);
+  $revPkg = "Krazy::PreProcess::Rev";
+  $code =~ s/^package\s+Krazy::PreProcess\s*;/package $revPkg;/m;
+  eval $code;    ## no critic
+  die "Cannot load Krazy::PreProcess of revision $rev: $@\n" if ($@);
+}
+
+# the lines of a documented C++ header of about $n lines, as fileLines() returns them
+sub header
+{
+  my ($n) = @_;
+  my (@l) = ();
+  for (my $i = 0 ; $#l < $n ; $i++) {
+    push(@l,
+      "/**\n",
+      " * Returns the value number $i.\n",
+      " * \@param key the key of the value; see also value" . ($i + 1) . "()\n",
+      " */\n",
+      "QString value$i(const QString &key = QStringLiteral(\"a\")) const; // the value $i\n",
+      "int m_count$i = 1'000; /* the count */ char m_sep$i = '\\'';\n",
+      "\n");
+    push(@l, "#if 0\n", "void unused$i();\n", "#endif\n") if ($i % 10 == 0);
+  }
+  return @l;
+}
+
+# the fastest of the runs of $code, in seconds, and its last result
+sub timeIt
+{
+  my ($code, @args) = @_;
+  my ($best, @result);
+  for (my $i = 0 ; $i < $runs ; $i++) {
+    my ($start) = time();
+    @result = &{$code}(@args);
+    my ($t) = time() - $start;
+    $best = $t if (!defined($best) || $t < $best);
+  }
+  return ($best, @result);
+}
+
+printf("Krazy::PreProcess timings, best of %d run%s%s\n", $runs, $runs > 1 ? "s" : "", $rev ? ", against $rev" : "");
+printf("%-20s %7s %10s %12s%s\n", "function", "lines", "time(ms)", "lines/s", $rev ? "  rev(ms)  speedup  output" : "");
+foreach my ($n) (split(",", $sizes)) {
+  my (@lines) = &header($n);
+  foreach my ($fn) (@functions) {
+    my ($t, @out) = &timeIt($fn->[1], "Krazy::PreProcess", @lines);
+    my ($cmp) = "";
+    if ($revPkg) {
+      my ($rt, @rout) = &timeIt($fn->[1], $revPkg, @lines);
+      my ($same) = (join("\n", @out) eq join("\n", @rout)) ? "same" : "differs";
+      $cmp = sprintf("  %7.1f  %6.1fx  %s", $rt * 1000, $t > 0 ? $rt / $t : 0, $same);
+    }
+    printf("%-20s %7d %10.1f %12.0f%s\n", $fn->[0], scalar(@lines), $t * 1000, $t > 0 ? @lines / $t : 0, $cmp);
+  }
+}
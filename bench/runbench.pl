@@ -0,0 +1,189 @@
+#!/usr/bin/perl -w
+
+###############################################################################
+# Times krazy2all on a benchmark source tree.                                 #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+# Runs krazy2all on the tree (see gencorpus.pl) with each of the check-sets
+# and reports the files checked per second, the checker invocations (checker
+# and file pairs) per second and the peak memory use of the run.
+# The results are written to a JSON file, which can be given as the baseline
+# of a later run to compare the two.
+
+# Program options:
+#   --help:            print a help message and exit
+#   --bindir <dir>:    the directory holding the krazy2all and krazy2 to time
+#   --sets <set[,set1,...,setN]>: the check-sets to run (default foss,kde,qt)
+#   --jobs <N>:        the number of jobs krazy2 runs at the same time (default: krazy2's)
+#   --runs <N>:        run each check-set N times, keeping the fastest run (default 1)
+#   --results <file>:  write the results to the specified JSON file
+#   --baseline <file>: compare with the results of an earlier run
+# Takes one command line argument: the benchmark tree.
+
+use warnings;
+use strict;
+use Getopt::Long;
+use Cwd 'abs_path';
+use JSON;
+use POSIX qw(strftime);
+use Time::HiRes qw(time);
+use FindBin qw($Bin);
+use lib "$Bin/../lib";
+use Krazy::Profile;
+
+my ($help)     = '';
+my ($bindir)   = '';
+my ($sets)     = "foss,kde,qt";
+my ($jobs)     = '';
+my ($runs)     = 1;
+my ($results)  = '';
+my ($baseline) = '';
+
+exit 1
+  if (
+  !GetOptions(
+    'help'       => \$help,
+    'bindir=s'   => \$bindir,
+    'sets=s'     => \$sets,
+    'jobs=i'     => \$jobs,
+    'runs=i'     => \$runs,
+    'results=s'  => \$results,
+    'baseline=s' => \$baseline,
+  )
+  );
+
+if ($help || $#ARGV != 0) {
+  print "Usage: runbench.pl [--bindir dir] [--sets set,...] [--jobs N] [--runs N] "
+    . "[--results file] [--baseline file] <tree>\n";
+  exit 0;
+}
+my ($tree) = abs_path($ARGV[0]);
+die "No such benchmark tree $ARGV[0]\n" if (!defined($tree) || !-d $tree);
+$runs = 1 if ($runs < 1);
+
+# run the krazy2 found in the bin directory
+$ENV{'PATH'} = abs_path($bindir) . ":$ENV{'PATH'}" if ($bindir);
+
+my ($opts) = "--ignorerc";
+$opts .= " --jobs=$jobs" if ($jobs);
+
+# run a command in the tree, with its stdout going to the specified file.
+# returns the wall time in seconds and the peak RSS in KB of the command.
+sub timeCommand
+{
+  my ($cmd, $out) = @_;
+
+  my ($start) = time();
+  my ($pid)   = fork();
+  die "Cannot fork: $!\n" if (!defined($pid));
+  if ($pid == 0) {
+    chdir($tree) or POSIX::_exit(127);
+    open(STDOUT, '>', $out);
+    open(STDERR, '>', '/dev/null');
+    exec($cmd) or POSIX::_exit(127);
+  }
+  my ($status, $usage) = &waitUsage($pid);
+  if (!defined($usage)) {
+    waitpid($pid, 0);
+    $status = $?;
+    $usage  = {'maxrss' => 0};
+  }
+  my ($wall) = time() - $start;
+  die "Cannot run \"$cmd\"\n" if (($status >> 8) == 127);
+  return ($wall, $usage->{'maxrss'});
+}
+
+# the number of (checker, file) pairs krazy2all checks with the specified set
+sub countInvocations
+{
+  my ($set) = @_;
+  my ($n) = 0;
+  foreach my ($line) (`cd '$tree' && krazy2all $opts --check-sets=$set --dry-run --export=textlist 2>/dev/null`) {
+    $n++ if ($line =~ m+/krazy-(?:plugins|extras)/+);
+  }
+  return $n;
+}
+
+my ($old) = {};
+if ($baseline) {
+  open(my $fh, '<', $baseline) or die "Cannot read the baseline $baseline: $!\n";
+  $old = decode_json(do {local $/; <$fh>});
+  close($fh);
+}
+
+my ($commit) = `git -C '$Bin' rev-parse --short HEAD 2>/dev/null`;
+$commit = "unknown" if (!$commit);
+chomp($commit);
+$commit .= "+" if (`git -C '$Bin' status --porcelain --untracked-files=no 2>/dev/null`);
+
+my ($corpus) = "";
+if (open(my $fh, '<', "$tree/CORPUS")) {
+  $corpus = <$fh>;
+  chomp($corpus);
+  close($fh);
+}
+
+print "Warning: the baseline is of a different tree ($old->{'corpus'})\n"
+  if ($baseline && defined($old->{'corpus'}) && $old->{'corpus'} ne $corpus);
+printf("krazy2 benchmark of %s on %s (%s), best of %d run%s\n", $commit, $tree, $corpus, $runs, $runs > 1 ? "s" : "");
+printf("%-10s %7s %11s %9s %9s %9s %8s %7s%s\n",
+  "check-set", "files", "invocations", "wall(s)", "files/s", "invoc/s", "RSS(MB)", "issues", $baseline ? "  vs baseline" : "");
+
+my (%sets);
+my ($out) = "/tmp/krazy-bench-$$.txt";
+foreach my ($set) (split(",", $sets)) {
+  my ($invocations) = &countInvocations($set);
+  my ($best, $rss) = (0, 0);
+  for (my $i = 0 ; $i < $runs ; $i++) {
+    my ($wall, $maxrss) = &timeCommand("krazy2all $opts --check-sets=$set", $out);
+    $best = $wall if ($i == 0 || $wall < $best);
+    $rss  = $maxrss if ($maxrss > $rss);
+  }
+
+  # the totals of the report
+  my ($files, $issues) = (0, 0);
+  open(my $fh, '<', $out) or die "Cannot read $out: $!\n";
+  while (my $line = <$fh>) {
+    $files  = $1 if ($line =~ m/^Files Processed = (\d+)/);
+    $issues = $1 if ($line =~ m/^Total Issues = (\d+)/);
+  }
+  close($fh);
+
+  my ($r) = {
+    'files'         => $files + 0,
+    'invocations'   => $invocations,
+    'wall'          => sprintf("%.3f", $best) + 0,
+    'files/s'       => sprintf("%.1f", $files / $best) + 0,
+    'invocations/s' => sprintf("%.1f", $invocations / $best) + 0,
+    'maxrss'        => $rss,
+    'issues'        => $issues + 0,
+  };
+  $sets{$set} = $r;
+
+  my ($cmp) = "";
+  my ($base) = $old->{'sets'}{$set};
+  if ($base && $base->{'wall'}) {
+    $cmp = sprintf("  %+.1f%% wall", ($r->{'wall'} - $base->{'wall'}) * 100 / $base->{'wall'});
+    $cmp .= ", issues differ ($base->{'issues'})" if ($base->{'issues'} != $r->{'issues'});
+  }
+  printf("%-10s %7d %11d %9.3f %9.1f %9.1f %8.1f %7d%s\n",
+    $set, $files, $invocations, $best, $r->{'files/s'}, $r->{'invocations/s'}, $rss / 1024, $issues, $cmp);
+}
+unlink($out);
+
+if ($results) {
+  my ($data) = {
+    'commit' => $commit,
+    'date'   => strftime("%Y-%m-%dT%H:%M:%SZ", gmtime()),
+    'corpus' => $corpus,
+    'jobs'   => $jobs ? $jobs + 0 : "default",
+    'runs'   => $runs,
+    'sets'   => \%sets,
+  };
+  open(my $fh, '>', $results) or die "Cannot write $results: $!\n";
+  print $fh JSON->new->pretty->canonical->encode($data);
+  close($fh);
+  print "Results written to $results\n";
+}
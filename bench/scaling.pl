@@ -0,0 +1,388 @@
+#!/usr/bin/perl -w
+
+###############################################################################
+# Finds checkers whose run time grows faster than their input.                #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+# Runs each checker program found in plugins/, extras/ and tplugins/ on
+# generated inputs of geometrically growing sizes, in several adversarial
+# shapes: many lines, long lines, many comments, deep nesting and huge
+# string literals.  The CPU time spent beyond the start-up time of the
+# checker is fitted to a power of the input size; an exponent above the
+# limit (default 1.3, a little over n*log(n) for these sizes) is flagged.
+#
+# A run taking longer than the timeout ends its series; it is flagged if the
+# growth needed to reach the timeout is above the limit.
+
+# Program options:
+#   --help:             print a help message and exit
+#   --plugins <s[,s1,...,sN]>: only run the checkers whose type/name contains one of these
+#   --shapes <s[,s1,...,sN]>: only generate these input shapes
+#   --min <N>:          the smallest input size, in lines (default 6250)
+#   --max <N>:          the largest input size, in lines (default 100000)
+#   --timeout <secs>:   the longest time a single run may take (default 20)
+#   --max-exponent <x>: flag a fitted exponent above this (default 1.3)
+#   --results <file>:   write the results to the specified JSON file
+# Exits with the number of flagged series (at most 255).
+
+use warnings;
+use strict;
+use Getopt::Long;
+use File::Find;
+use File::Temp qw(tempdir);
+use JSON;
+use POSIX qw(:sys_wait_h);
+use Time::HiRes qw(time);
+use FindBin qw($Bin);
+use lib "$Bin/../lib";
+use Krazy::Profile;
+
+my ($help)     = '';
+my ($plugins)  = '';
+my ($shapes)   = '';
+my ($min)      = 6250;
+my ($max)      = 100000;
+my ($timeout)  = 20;
+my ($maxexp)   = 1.3;
+my ($results)  = '';
+
+exit 1
+  if (
+  !GetOptions(
+    'help'           => \$help,
+    'plugins=s'      => \$plugins,
+    'shapes=s'       => \$shapes,
+    'min=i'          => \$min,
+    'max=i'          => \$max,
+    'timeout=i'      => \$timeout,
+    'max-exponent=f' => \$maxexp,
+    'results=s'      => \$results,
+  )
+  );
+
+if ($help || $#ARGV >= 0) {
+  print "Usage: scaling.pl [--plugins name,...] [--shapes shape,...] [--min N] [--max N] "
+    . "[--timeout secs] [--max-exponent x] [--results file]\n";
+  exit 0;
+}
+
+# runs below this many seconds (beyond the start-up time) are mostly noise
+my ($NOISE) = 0.05;
+
+# the checkers run straight from the source tree
+$ENV{'PERL5LIB'} = "$Bin/../lib" . (defined($ENV{'PERL5LIB'}) ? ":$ENV{'PERL5LIB'}" : "");
+
+#==============================================================================
+# The input generators.  Each returns the text of an input of about $n lines
+# worth of content, for a file type.
+#==============================================================================
+
+# a block of ordinary C++, 15 lines
+sub cppUnit
+{
+  my ($i) = @_;
+  return (
+    "class Foo$i : public QObject",
+    "{",
+    "  Q_OBJECT",
+    "public:",
+    "  explicit Foo$i(QObject *p = 0);",
+    "  QString name$i() const;",
+    "private:",
+    "  int m_count$i;",
+    "};",
+    "void Foo${i}::bar(const QString &s)",
+    "{",
+    "  if (s.isEmpty()) {",
+    "    qDebug() << \"empty\" << m_count$i;",
+    "  }",
+    "}",
+  );
+}
+
+sub cppLines
+{
+  my ($n) = @_;
+  my (@l);
+  push(@l, &cppUnit($#l)) while ($#l < $n);
+  return join("\n", @l) . "\n";
+}
+
+# all the code on a single line
+sub cppLongLine
+{
+  my ($n) = @_;
+  my ($text) = &cppLines($n);
+  $text =~ s/\n/ /g;
+  return "$text\n";
+}
+
+sub cppComments
+{
+  my ($n) = @_;
+  my ($text) = "";
+  for (my $i = 0 ; $i < $n ; $i += 3) {
+    $text .= "int v$i; /* comment $i */ int w$i;\n// line comment $i\n/* a comment\n";
+    $text .= "   over two lines $i */\n" if ($i % 2);
+    $text .= "*/\n" if (!($i % 2));
+  }
+  return $text;
+}
+
+sub cppNesting
+{
+  my ($n) = @_;
+  my ($text) = "void f()\n{\n";
+  $text .= "if (a$_) {\n" foreach (1 .. $n / 2);
+  $text .= "}\n" x ($n / 2);
+  return $text . "}\n";
+}
+
+# one string literal as large as $n lines of code
+sub cppStrings
+{
+  my ($n) = @_;
+  return "const char *s = \"" . ("abc /* not a comment */ // \\\"quoted\\\" " x $n) . "\";\n";
+}
+
+# the lines of a generic line-based file, repeating the line made by $make
+sub repeat
+{
+  my ($n, $head, $make, $tail) = @_;
+  return $head . join("", map {&$make($_)} (1 .. $n)) . $tail;
+}
+
+sub xmlLongLine
+{
+  my ($text) = @_;
+  $text =~ s/\n\s*//g;
+  return "$text\n";
+}
+
+my (%shapes) = (
+  'c++' => {
+    'lines'    => \&cppLines,
+    'longline' => \&cppLongLine,
+    'comments' => \&cppComments,
+    'nesting'  => \&cppNesting,
+    'strings'  => \&cppStrings,
+  },
+  'desktop' => {
+    'lines' => sub {
+      &repeat($_[0], "[Desktop Entry]\nType=Application\nName=Scaling\n", sub {"Name[x$_[0]]=Scaling $_[0]\n"}, "");
+    },
+    'longline' => sub {"[Desktop Entry]\nType=Application\nName=Scaling\nComment=" . ("a long comment " x $_[0]) . "\n"},
+  },
+  'json' => {
+    'lines' => sub {
+      "{\n  \"Entries\": [\n" . join(",\n", map {"    { \"Name\": \"entry $_\" }"} (1 .. $_[0])) . "\n  ]\n}\n";
+    },
+    'nesting' => sub {("{ \"a\": " x ($_[0] / 2)) . "1" . (" }" x ($_[0] / 2)) . "\n"},
+  },
+  'kconfigxt' => {
+    'lines' => sub {
+      &repeat($_[0] / 3,
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<kcfg>\n  <kcfgfile name=\"scalingrc\"/>\n  <group name=\"General\">\n",
+        sub {"    <entry name=\"Setting$_[0]\" type=\"Int\">\n      <default>$_[0]</default>\n    </entry>\n"},
+        "  </group>\n</kcfg>\n");
+    },
+  },
+  'designer' => {
+    'lines' => sub {
+      &repeat($_[0] / 3,
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ui version=\"4.0\">\n <class>Scaling</class>\n"
+          . " <widget class=\"QWidget\" name=\"Scaling\">\n",
+        sub {"  <widget class=\"QLabel\" name=\"label$_[0]\">\n   <property name=\"text\"><string>Label &amp;$_[0]</string></property>\n  </widget>\n"},
+        " </widget>\n</ui>\n");
+    },
+  },
+  'kpartgui' => {
+    'lines' => sub {
+      &repeat($_[0],
+        "<!DOCTYPE gui SYSTEM \"kpartgui.dtd\">\n<gui name=\"scaling\" version=\"1\">\n<MenuBar>\n<Menu name=\"file\">\n",
+        sub {"  <Action name=\"action$_[0]\"/>\n"},
+        "</Menu>\n</MenuBar>\n</gui>\n");
+    },
+  },
+  'svg' => {
+    'lines' => sub {
+      &repeat($_[0], "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\">\n",
+        sub {"  <rect x=\"$_[0]\" y=\"1\" width=\"2\" height=\"2\"/>\n"}, "</svg>\n");
+    },
+  },
+  'python' => {
+    'lines' => sub {&repeat($_[0] / 2, "", sub {"def f$_[0](self):\n    self.changed.emit($_[0])\n"}, "")},
+  },
+);
+$shapes{'kconfigxt'}{'longline'} = sub {&xmlLongLine($shapes{'kconfigxt'}{'lines'}->(@_))};
+$shapes{'designer'}{'longline'}  = sub {&xmlLongLine($shapes{'designer'}{'lines'}->(@_))};
+$shapes{'svg'}{'longline'}       = sub {&xmlLongLine($shapes{'svg'}{'lines'}->(@_))};
+
+# the file names to check for each file type; general checkers get C++
+my (%names) = (
+  'c++'       => ['scaling.cpp', 'scaling.h'],
+  'general'   => ['scaling.cpp'],
+  'desktop'   => ['scaling.desktop'],
+  'json'      => ['scaling.json'],
+  'kconfigxt' => ['scaling.kcfg'],
+  'designer'  => ['scaling.ui'],
+  'kpartgui'  => ['scalingui.rc'],
+  'svg'       => ['scaling.svg'],
+  'python'    => ['scaling.py'],
+);
+
+#==============================================================================
+# Running and fitting
+#==============================================================================
+
+# run a checker on a file; returns the CPU seconds used, or undef on timeout
+sub runChecker
+{
+  my ($checker, $file) = @_;
+
+  my ($start) = time();
+  my ($pid)   = fork();
+  die "Cannot fork: $!\n" if (!defined($pid));
+  if ($pid == 0) {
+    open(STDOUT, '>', '/dev/null');
+    open(STDERR, '>', '/dev/null');
+    exec($checker, "--krazy", "--priority", "all", "--strict", "all", "--verbose", $file) or POSIX::_exit(127);
+  }
+  my (@before) = &childTimes();
+  while (waitpid($pid, WNOHANG) == 0) {
+    if (time() - $start > $timeout) {
+      kill('KILL', $pid);
+      waitpid($pid, 0);
+      return undef;    ## no critic
+    }
+    Time::HiRes::sleep(0.002);
+  }
+  my (@after) = &childTimes();
+  return ($after[0] - $before[0]) + ($after[1] - $before[1]);
+}
+
+# the least squares slope of log(time) over log(size)
+sub fitExponent
+{
+  my (@points) = @_;
+  return undef if ($#points < 1);    ## no critic
+  my ($n) = scalar(@points);
+  my ($sx, $sy, $sxx, $sxy) = (0, 0, 0, 0);
+  foreach my ($p) (@points) {
+    my ($x, $y) = (log($p->[0]), log($p->[1]));
+    $sx  += $x;
+    $sy  += $y;
+    $sxx += $x * $x;
+    $sxy += $x * $y;
+  }
+  my ($d) = $n * $sxx - $sx * $sx;
+  return undef if ($d == 0);    ## no critic
+  return ($n * $sxy - $sx * $sy) / $d;
+}
+
+# the checker programs, as type/name => path
+my (%checkers);
+find(
+  sub {
+    return if (!-f $_ || !-x $_ || $File::Find::dir =~ m+/oplugins\b+);
+    my ($dir) = $File::Find::dir;
+    $dir =~ s+.*/++;
+    my ($type) = ($dir eq "tplugins") ? "c++" : $dir;
+    $checkers{"$type/$_"} = $File::Find::name;
+  },
+  "$Bin/../plugins",
+  "$Bin/../extras",
+  "$Bin/../tplugins"
+);
+
+my (@sizes);
+for (my $n = $min ; $n <= $max ; $n *= 2) {
+  push(@sizes, $n);
+}
+my (%wanted) = map {$_ => 1} split(",", $shapes);
+
+my ($tmp) = tempdir("krazy-scaling-XXXXXX", TMPDIR => 1, CLEANUP => 1);
+printf("%-26s %-16s %-9s %s %9s\n", "checker", "file", "shape", join(" ", map {sprintf("%7d", $_)} @sizes), "exponent");
+
+my (@series);
+my ($flagged) = 0;
+foreach my ($key) (sort keys %checkers) {
+  next if ($plugins && !grep {index($key, $_) >= 0} split(",", $plugins));
+  my ($type) = $key;
+  $type =~ s+/.*++;
+  next if (!defined($names{$type}));
+  my ($gen) = $shapes{$type eq "general" ? "c++" : $type};
+
+  foreach my ($name) (@{$names{$type}}) {
+    my ($file) = "$tmp/$name";
+
+    # the start-up time of the checker
+    open(my $fh, '>', $file) or die "Cannot write $file: $!\n";
+    print $fh $gen->{'lines'}->(15);
+    close($fh);
+    my ($startup) = &runChecker($checkers{$key}, $file);
+    next if (!defined($startup));
+
+    foreach my ($shape) (sort keys %{$gen}) {
+      next if ($shapes && !$wanted{$shape});
+      my (@points, @cells);
+      my ($timedout) = 0;
+      foreach my ($n) (@sizes) {
+        open($fh, '>', $file) or die "Cannot write $file: $!\n";
+        print $fh $gen->{$shape}->($n);
+        close($fh);
+        my ($t) = &runChecker($checkers{$key}, $file);
+        if (!defined($t)) {
+          $timedout = $n;
+          push(@cells, sprintf("%7s", ">$timeout"));
+          last;
+        }
+        $t -= $startup;
+        push(@points, [$n, $t]) if ($t >= $NOISE);
+        push(@cells,  sprintf("%7.2f", $t > 0 ? $t : 0));
+      }
+
+      my ($exp) = &fitExponent(@points);
+      my ($bad) = (defined($exp) && $exp > $maxexp);
+      if ($timedout) {
+
+        # the growth from the last finished run needed to reach the timeout
+        my ($last) = $#points >= 0 ? $points[-1] : undef;
+        my ($lower) = ($last && $last->[0] < $timedout) ? log($timeout / $last->[1]) / log($timedout / $last->[0]) : undef;
+        $exp = $lower if (defined($lower) && (!defined($exp) || $lower > $exp));
+        $bad = 1 if (!defined($lower) || $lower > $maxexp);
+      }
+      $flagged++ if ($bad);
+      push(@cells, sprintf("%7s", "")) while ($#cells < $#sizes);
+      printf("%-26s %-16s %-9s %s %9s%s\n",
+        $key, $name, $shape, join(" ", @cells),
+        defined($exp) ? sprintf("%s%.2f", $timedout ? ">" : "", $exp) : "-",
+        $bad ? "  SUPER-LINEAR" : "");
+
+      push(
+        @series,
+        {
+          'checker'  => $key,
+          'file'     => $name,
+          'shape'    => $shape,
+          'startup'  => $startup,
+          'times'    => [map {{'size' => $_->[0], 'cpu' => $_->[1]}} @points],
+          'timeout'  => $timedout ? $timedout : \0,
+          'exponent' => $exp,
+          'flagged'  => $bad ? \1 : \0,
+        }
+      );
+    }
+  }
+}
+
+print "$flagged series grow faster than n^$maxexp\n";
+
+if ($results) {
+  open(my $fh, '>', $results) or die "Cannot write $results: $!\n";
+  print $fh JSON->new->pretty->canonical->encode({'sizes' => \@sizes, 'max-exponent' => $maxexp, 'series' => \@series});
+  close($fh);
+}
+exit($flagged > 255 ? 255 : $flagged);
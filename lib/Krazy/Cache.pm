@@ -0,0 +1,174 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Cache;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use Digest::MD5 qw(md5_hex);
+use File::Find;
+use File::Path qw(make_path);
+use File::Temp qw(tempfile);
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(validateCacheSize cacheKey checkerVersion cacheGet cachePut cachePrune);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# A content-addressed cache of checker results.
+#
+# Each result is the raw output and exit status of one checker program run
+# on one file, stored under a key made from everything that can change the
+# result: the file content hash and path, the checker program content and
+# version, and the options given to the checker.
+#
+# The cache is a directory that can be shared by several runs at the same
+# time: entries are written to a temporary file which is then renamed into
+# place, so readers only ever see complete entries.  Reading an entry
+# refreshes its modification time, which is used when pruning.
+#==============================================================================
+
+# return the number of bytes in the specified size, which may have a K, M or G
+# suffix, or undef if the size is not valid
+sub validateCacheSize
+{
+  my ($size) = @_;
+  return undef if (!defined($size) || $size !~ m/^(\d+)([KkMmGg]?)$/);    ## no critic
+  my ($n, $unit) = ($1, lc($2));
+  $n *= 1024 if ($unit eq "k");
+  $n *= 1024 * 1024 if ($unit eq "m");
+  $n *= 1024 * 1024 * 1024 if ($unit eq "g");
+  return $n;
+}
+
+# return the cache key for the specified list of key parts
+sub cacheKey
+{
+  my (@parts) = @_;
+  return md5_hex(join("\0", map {defined($_) ? $_ : ""} @parts));
+}
+
+# return the path of the cache entry for the specified key
+sub entryPath
+{
+  my ($dir, $key) = @_;
+  return "$dir/" . substr($key, 0, 2) . "/$key";
+}
+
+# write the data to the specified path atomically
+sub writeAtomic
+{
+  my ($path, $data) = @_;
+
+  my ($subdir) = $path;
+  $subdir =~ s+/[^/]*$++;
+  make_path($subdir) if (!-d $subdir);
+
+  my ($fh, $tmp) = eval {tempfile(".tmp-XXXXXX", DIR => $subdir);};
+  return 0 if (!$fh);
+  binmode($fh);
+  print $fh $data;
+  if (!close($fh) || !rename($tmp, $path)) {
+    unlink($tmp);
+    return 0;
+  }
+  return 1;
+}
+
+# return the version string of the specified checker program, which has the
+# specified content hash.  versions are remembered in the cache directory so
+# each checker program is asked only once.
+sub checkerVersion
+{
+  my ($dir, $p, $md5) = @_;
+
+  my ($path) = "$dir/versions/$md5";
+  if (open(my $fh, '<', $path)) {
+    my ($v) = <$fh>;
+    close($fh);
+    if (defined($v)) {
+      chomp($v);
+      return $v;
+    }
+  }
+
+  my ($v) = `$p --version 2>/dev/null`;
+  $v = "" if (!defined($v));
+  chomp($v);
+  &writeAtomic($path, "$v\n");
+  return $v;
+}
+
+# return the cached (output, exit status) for the key, or an empty list on a miss
+sub cacheGet
+{
+  my ($dir, $key) = @_;
+
+  my ($path) = &entryPath($dir, $key);
+  open(my $fh, '<:raw', $path) or return ();
+  my ($data) = do {local $/; <$fh>};
+  close($fh);
+  return () if (!defined($data) || $data !~ s/^(\d+)\n//);
+  my ($status) = $1;
+
+  utime(undef, undef, $path);
+  return ($data, $status);
+}
+
+# store the output and exit status under the key.
+# returns 1 on success, 0 otherwise.
+sub cachePut
+{
+  my ($dir, $key, $out, $status) = @_;
+  return &writeAtomic(&entryPath($dir, $key), "$status\n$out");
+}
+
+# remove cache entries older than $maxage days, then remove the least recently
+# used entries until the cache holds at most $maxsize bytes.  either limit may
+# be undef or 0, for no limit.  returns the number of entries removed.
+sub cachePrune
+{
+  my ($dir, $maxsize, $maxage) = @_;
+  return 0 if (!-d $dir);
+
+  my (@entries) = ();
+  find(
+    sub {
+      return if (!-f $_ || $File::Find::dir =~ m+/versions$+);
+      my (@st) = stat($_);
+      push(@entries, [$File::Find::name, $st[7], $st[9]]);
+    },
+    $dir
+  );
+
+  my ($removed) = 0;
+  my ($now)     = time();
+  my ($total)   = 0;
+  my (@keep)    = ();
+  foreach my ($e) (@entries) {
+    if ($maxage && $now - $e->[2] > $maxage * 24 * 60 * 60) {
+      $removed += unlink($e->[0]);
+    } else {
+      push(@keep, $e);
+      $total += $e->[1];
+    }
+  }
+
+  if ($maxsize) {
+    foreach my ($e) (sort {$a->[2] <=> $b->[2]} @keep) {
+      last if ($total <= $maxsize);
+      $removed += unlink($e->[0]);
+      $total -= $e->[1];
+    }
+  }
+  return $removed;
+}
+
+1;
@@ -0,0 +1,348 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Decls;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use Cwd 'abs_path';
+use Digest::MD5 qw(md5_hex);
+use File::Find;
+use Krazy::Store;
+use Krazy::Lexer;
+use Krazy::Source;
+use Krazy::Utils;
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(declsPath declsOpen declsScan declsFile declsData declsDigest declsSave);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# A database of the C++ classes declared in the headers of a project, so the
+# checkers can know about the classes of the other headers: their bases,
+# whether they are exported, their constructors and member variables.
+#
+# declsScan($root) indexes all the C/C++ headers below the top of the project
+# in one pass.  A header is parsed again only when its content hash changed;
+# its modification time and size tell when the hash must be computed again.
+# The database is a store (see Krazy::Store), written back at exit if anything
+# changed.
+#
+# The database is a hash holding:
+#   files:   absolute header path => {stamp, md5, classes}
+#   classes: class name (without qualification) => list of class records
+# and each class record is a hash holding:
+#   name, qname: the class name as written, and qualified with the names
+#                of the enclosing namespaces and classes
+#   kind:        class, struct or union
+#   file, line:  the absolute path of the header and the line of the keyword
+#   exported:    true if an export macro is in the head
+#   template:    true if the class is a template
+#   bases:       the base class names, without qualification nor template
+#                arguments
+#   ctors:       the constructors, as {line, explicit, params, required}
+#                hashes (the numbers of parameters and of those without a
+#                default value)
+#   members:     the member variables, as {line, name, access, static} hashes
+#
+# The checkers query it through declClasses() and declInherits() in
+# Krazy::Utils.
+#==============================================================================
+
+my ($FORMAT) = 1;     # the version of the database layout
+my ($Path)   = '';    # the database file, if in use
+my ($Dirty)  = 0;     # true if the database needs saving
+my (%Decls)  = ('format' => $FORMAT, 'files' => {}, 'classes' => {});
+
+# return the default database file of the project at the specified top
+# directory, under the XDG cache directory
+sub declsPath
+{
+  my ($root) = @_;
+  return &storePath('decls', md5_hex(abs_path($root) || $root));
+}
+
+# start using the database in the specified file, which may not exist yet
+sub declsOpen
+{
+  my ($path) = @_;
+
+  $Path = $path;
+  my ($d) = &storeOpen($path, $FORMAT);
+  %Decls = %{$d} if ($d);
+}
+
+# index the C/C++ headers below the specified directory, taking the content
+# of the files krazy2 read already from the hash of absolute paths to
+# content references.  Returns the number of headers indexed and the number
+# of those parsed again.
+sub declsScan
+{
+  my ($root, $known) = @_;
+  $known = {} if (!$known);
+
+  my (%seen)   = ();
+  my ($parsed) = 0;
+  find(
+    {
+      'preprocess' => sub {
+        return grep {!m/^\./} @_;    # no .git and the like
+      },
+      'wanted' => sub {
+        return if (!-f $_ || !&isCInclude($_));
+        my ($absf) = $File::Find::name;
+        my (@st) = stat(_);
+        my ($stamp) = "$st[9]:$st[7]";
+        $seen{$absf} = 1;
+        my ($entry) = $Decls{'files'}{$absf};
+        return if ($entry && $entry->{'stamp'} eq $stamp);
+
+        my ($ref) = $known->{$absf};
+        if (!$ref) {
+          open my $fh, '<:raw', $_ or return;
+          my ($content) = do {local $/; <$fh>};
+          close($fh);
+          $content = "" if (!defined($content));
+          $ref = \$content;
+        }
+        my ($md5) = md5_hex(${$ref});
+        if (!$entry || $entry->{'md5'} ne $md5) {
+          $entry = {'md5' => $md5, 'classes' => &declsFile($absf, $ref)};
+          $parsed++;
+        }
+        $entry->{'stamp'} = $stamp;
+        $Decls{'files'}{$absf} = $entry;
+        $Dirty = 1;
+      },
+      'no_chdir' => 0,
+    },
+    abs_path($root) || $root
+  );
+
+  foreach my ($absf) (keys %{$Decls{'files'}}) {
+    next if ($seen{$absf});
+    delete($Decls{'files'}{$absf});
+    $Dirty = 1;
+  }
+  &indexClasses() if ($Dirty || !%{$Decls{'classes'}});
+  return (scalar(keys %seen), $parsed);
+}
+
+# rebuild the index of the classes by name
+sub indexClasses
+{
+  my (%classes) = ();
+  foreach my ($absf) (sort keys %{$Decls{'files'}}) {
+    foreach my ($c) (@{$Decls{'files'}{$absf}{'classes'}}) {
+      my ($name) = $c->{'name'};
+      $name =~ s/^.*:://;
+      push(@{$classes{$name}}, $c);
+    }
+  }
+  $Decls{'classes'} = \%classes;
+}
+
+# add the constructors and member variables declared by the statement made
+# of the specified tokens (with the parentheses folded into their opening
+# token, holding the number of parameters in 'params' and 'required')
+sub addStatement
+{
+  my ($record, $short, $access, @stmt) = @_;
+
+  # leading macros, like Q_OBJECT and Q_PROPERTY(...), end with no semicolon
+  while ($#stmt >= 0 && $stmt[0]->{'text'} =~ m/^[A-Z][A-Z0-9_]+$/ && $stmt[0]->{'type'} eq 'ident') {
+    shift(@stmt);
+    shift(@stmt) if ($#stmt >= 0 && $stmt[0]->{'text'} eq '(');
+  }
+  return if ($#stmt < 0);
+  return if ($stmt[0]->{'text'} =~ m/^(template|friend|using|typedef|static_assert|enum|class|struct|union|namespace)$/);
+
+  my ($paren) = -1;
+  for (my $j = 0 ; $j <= $#stmt ; $j++) {
+    last if ($stmt[$j]->{'text'} eq '=');
+    if ($stmt[$j]->{'text'} eq '(') {
+      $paren = $j;
+      last;
+    }
+  }
+  if ($paren > 0) {
+
+    # a function; a constructor has the name of the class
+    my ($name) = $stmt[$paren - 1]->{'text'};
+    return if ($name ne $short || ($paren > 1 && $stmt[$paren - 2]->{'text'} eq '~'));
+    push(
+      @{$record->{'ctors'}},
+      {
+        'line'     => $stmt[$paren - 1]->{'line'},
+        'explicit' => (grep {$_->{'text'} eq 'explicit'} @stmt[0 .. $paren - 1]) ? 1 : 0,
+        'params'   => $stmt[$paren]->{'params'},
+        'required' => $stmt[$paren]->{'required'},
+      }
+    );
+    return;
+  }
+
+  # member variables, one for each declarator
+  my ($static) = (grep {$_->{'text'} eq 'static'} @stmt) ? 1 : 0;
+  my ($name, $done) = (undef, 0);
+  foreach my ($tok) (@stmt, {'text' => ',', 'type' => 'punct'}) {
+    my ($t) = $tok->{'text'};
+    if ($t eq ',') {
+      push(@{$record->{'members'}}, {'line' => $name->{'line'}, 'name' => $name->{'text'}, 'access' => $access, 'static' => $static})
+        if ($name);
+      ($name, $done) = (undef, 0);
+    } elsif ($t =~ m/^(=|\[|:|\{)$/) {
+      $done = 1;
+    } elsif (!$done && $tok->{'type'} eq 'ident') {
+      $name = $tok;
+    }
+  }
+}
+
+# return the number of parameters and of required parameters of the
+# parameter list in the parentheses starting at token $i
+sub paramCounts
+{
+  my ($tokens, $i) = @_;
+
+  my ($close) = $tokens->[$i]->{'match'};
+  return (0, 0) if (!defined($close));
+  my (@args) = grep {$_->{'type'} ne 'comment'} @{$tokens}[$i + 1 .. $close - 1];
+  return (0, 0) if ($#args < 0 || ($#args == 0 && $args[0]->{'text'} eq 'void'));
+
+  my ($params, $required, $default, $nest) = (1, 0, 0, 0);
+  foreach my ($tok) (@args) {
+    my ($t) = $tok->{'text'};
+    if ($t =~ m/^[\(\[\{<]$/) {
+      $nest++;
+    } elsif ($t =~ m/^[\)\]\}>]$/) {
+      $nest--;
+    } elsif ($t eq '>>') {
+      $nest -= 2;
+    } elsif ($t eq '=' && $nest <= 0) {
+      $default = 1;
+    } elsif ($t eq ',' && $nest <= 0) {
+      $required++ if (!$default);
+      $params++;
+      $default = 0;
+    }
+  }
+  $required++ if (!$default);
+  return ($params, $required);
+}
+
+# return the class records of the specified header, with the content
+# given as a reference
+sub declsFile
+{
+  my ($f, $ref) = @_;
+
+  my ($source) = Krazy::Source->new($f, $ref);
+  my ($tokens) = $source->tokens();
+  my ($scopes) = $source->scopes();
+  my (@records) = ();
+  for (my $i = 0 ; $i <= $#{$scopes} ; $i++) {
+    my ($scope) = $scopes->[$i];
+    next if ($scope->{'kind'} eq 'namespace' || $scope->{'name'} eq "");
+
+    my (@outer) = ();
+    for (my $p = $scope->{'parent'} ; $p >= 0 ; $p = $scopes->[$p]->{'parent'}) {
+      unshift(@outer, $scopes->[$p]->{'name'}) if ($scopes->[$p]->{'name'} ne "");
+    }
+    my ($short) = $scope->{'name'};
+    $short =~ s/^.*:://;
+    my ($record) = {
+      'name'     => $scope->{'name'},
+      'qname'    => join("::", @outer, $scope->{'name'}),
+      'kind'     => $scope->{'kind'},
+      'file'     => $f,
+      'line'     => $scope->{'line'},
+      'exported' => $scope->{'exported'},
+      'template' => $scope->{'template'},
+      'bases'    => [&scopeBases($tokens, $scope)],
+      'ctors'    => [],
+      'members'  => [],
+    };
+
+    # the statements of the class body, split at the semicolons and after
+    # the function bodies, and at the access labels
+    my ($access)  = $scope->{'kind'} eq 'class' ? 'private' : 'public';
+    my (@labels)  = @{$scope->{'sections'}};
+    my ($depth)   = $tokens->[$scope->{'open'}]->{'depth'} + 1;
+    my ($last)    = defined($scope->{'close'}) ? $scope->{'close'} - 1 : $#{$tokens};
+    my (@stmt)    = ();
+    my ($isFunc)  = 0;
+    for (my $j = $scope->{'open'} + 1 ; $j <= $last ; $j++) {
+      my ($tok) = $tokens->[$j];
+      my ($t) = $tok->{'text'};
+      next if ($tok->{'type'} eq 'comment' || $tok->{'type'} eq 'directive');
+      if ($#labels >= 0 && $labels[0]->[0] == $tok->{'line'} && $t =~ m/^(public|protected|private|signals|Q_SIGNALS)$/) {
+        &addStatement($record, $short, $access, @stmt);
+        @stmt   = ();
+        $isFunc = 0;
+        $access = shift(@labels)->[1];
+        $j++ while ($j < $last && $tokens->[$j]->{'text'} ne ':');
+        next;
+      }
+      if ($t eq ';') {
+        &addStatement($record, $short, $access, @stmt);
+        @stmt   = ();
+        $isFunc = 0;
+      } elsif ($t eq '(' && defined($tok->{'match'})) {
+        my ($params, $required) = &paramCounts($tokens, $j);
+        push(@stmt, {%{$tok}, 'params' => $params, 'required' => $required});
+        $isFunc = 1;
+        $j = $tok->{'match'};
+      } elsif (($t eq '{' || $t eq '[') && defined($tok->{'match'})) {
+        push(@stmt, $tok);
+        $j = $tok->{'match'};
+        if ($t eq '{' && $isFunc) {
+
+          # a function body, which needs no semicolon
+          &addStatement($record, $short, $access, @stmt);
+          @stmt   = ();
+          $isFunc = 0;
+          $j++ if ($j < $last && $tokens->[$j + 1]->{'text'} eq ';');
+        }
+      } else {
+        push(@stmt, $tok);
+      }
+    }
+    push(@records, $record);
+  }
+  return \@records;
+}
+
+# return the database, as described above
+sub declsData
+{
+  return \%Decls;
+}
+
+# return a hash of the content of all the headers indexed, which changes
+# whenever any of them changes
+sub declsDigest
+{
+  return md5_hex(join("\n", map {"$_ $Decls{'files'}{$_}{'md5'}"} sort keys %{$Decls{'files'}}));
+}
+
+# write the database back to its file, if anything changed.
+# returns 1 on success (or when there was nothing to write), 0 otherwise.
+sub declsSave
+{
+  return 1 if (!$Path || !$Dirty);
+  return 0 if (!&storeSave($Path, \%Decls));
+  $Dirty = 0;
+  return 1;
+}
+
+&storeAtExit(\&declsSave);
+
+1;
@@ -0,0 +1,497 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Header;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use Cwd 'abs_path';
+use Digest::MD5 qw(md5_hex);
+use File::Basename;
+use Krazy::PatternSet;
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(isBusinessEntity isGroupAuthorsEntity reuseDigest);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# The license and copyright header of a file, analyzed once for the
+# copyright, license and reuse checkers.
+#
+# Krazy::Header->new($f, \@lines) looks at the first lines of the file (the
+# ones any of the checkers reads) and records what each one holds, so the
+# checkers walk those records with their own rules instead of each matching
+# the same lists of regular expressions again:
+#   records():     the lines, as hashes of:
+#                    'text':          the line
+#                    'skip':          1 for a //krazy:skip directive
+#                    'excludeall':    the text after a //krazy:excludeall=
+#                    'exclude':       the text after a //krazy:exclude=
+#                    'generated':     1 if it tells the file is generated
+#                    'waived':        1 if it puts the file in the public domain
+#                    'exempt':        1 if it puts the file in the public domain
+#                                     or under a permissive notice needing no
+#                                     SPDX lines
+#                    'spdxcopyright': 1 for a SPDX-FileCopyrightText line
+#                    'spdxlicense':   1 for a SPDX-License-Identifier line
+#                    'copyright':     1 if it uses the word copyright to give one
+#   directive($r, $prog): 'all' if the record skips the file for the checker,
+#                  'line' if it excludes itself, else ''
+#   licenseText(): the legacy license text of the first 40 lines, with only
+#                  letters, digits, '.', '@' and single spaces kept
+#   reuseInfo():   the SPDX information given for the file outside of it, by
+#                  a .license sidecar file or a REUSE.toml annotation (see
+#                  <https://reuse.software/spec>), as a hash of 'source' (the
+#                  file giving it), 'precedence' (closest, aggregate or
+#                  override), 'copyrights' and 'licenses'; undef if none
+#   missingLicenses(@expressions): the license identifiers of the SPDX
+#                  expressions without a file in the LICENSES directory of
+#                  the project; none if the project has no such directory
+#
+# Krazy::Source->forFile($f)->header() returns the analysis of a file, which
+# krazy2 makes before starting the checkers declaring "header=yes", so the
+# checkers running in forked copies of krazy2 share it.  The REUSE.toml files
+# and the LICENSES directories are read once per process.
+#==============================================================================
+
+my ($MAXLINES) = 100;    # the most lines without an exclude directive a checker reads
+my ($MINLINES) = 40;     # the lines of the legacy license text
+
+# REUSE-IgnoreStart
+
+# the lines telling the file is generated
+my ($Generated) = Krazy::PatternSet->new(
+  [
+    "generated from",
+    "generated by",
+    "uic-generated",
+    "changes made in this file will be lost",
+    "produced by gperf",
+    "This file is automatically generated",
+    "created by dcopidl2cpp",
+  ],
+  'literal' => 1
+);
+
+# the lines using the word copyright without giving one
+my ($NotCopyright) = Krazy::PatternSet->new(
+  [
+    '[[:alnum:]]copyright',
+    ' copyrighted',
+    ' copyright holder',
+    ' above copyright',
+    ' copyright notice',
+    ' infringement of copyright',
+    ' disclaims copyright',
+    ' the copyright',
+    ' copyrights',
+    ' AUTHORS OR COPYRIGHT',
+    '(?-i:Copyright\.txt)',
+    'Copyright\.html',
+  ],
+  'icase' => 1
+);
+
+# the businesses and legal entities, which may hold a copyright without
+# giving an email address
+my ($Businesses) = Krazy::PatternSet->new(
+  [
+    'Datakonsult',
+    'KDAB',
+    'Kitware, inc',
+    'Apple Computer',
+    'Apple\s*,?\s*Inc',
+    'Free Software Foundation',
+    '(World Wide Web Consortium|W3C)',
+    'Aladdin Enterprises',
+    'SUSE Linux',
+    'Open Group',
+    'Netscape',
+    'NLNet Labs',
+    'Nokia',
+    'Novell, Inc',
+    'Tridia Corporation',
+    'AT\&T Laboratories',
+    'X Consortium',
+    'heXoNet Support',
+    'Trolltech AS',
+    'Lucent Tech',
+    'University of California',
+    'Sendmail\, INC',
+    'Sun Microsystems',
+    'Network Computing Devices',
+    'MP3tunes, LLC',
+    '4Front Technologies',
+    'Critical Path',
+    'Ximian',
+    'Intevation GmbH',
+    'Bundesamt für Sicherheit in der Informationstechnik',
+    'ScalingWeb',
+    'Red Hat',
+    'Digia Plc',
+    'Canonical',
+    'Fastmail Pty',
+    'Hiram Clawson',
+  ],
+  'icase' => 1
+);
+
+my (%Tomls)    = ();    # REUSE.toml path => its annotations
+my (%Dirs)     = ();    # directory => the REUSE.toml files applying to it, the nearest first
+my (%Licenses) = ();    # directory => its LICENSES directory, or ''
+my (%Listing)  = ();    # LICENSES directory => hash of the licenses it holds
+
+# isBusinessEntity function: return true if the copyright line names a
+# business or a legal entity
+sub isBusinessEntity
+{
+  my ($line) = @_;
+  return $Businesses->test($line);
+}
+
+# isGroupAuthorsEntity function: return true if the copyright line names the
+# authors of a project, like "the Project authors"
+sub isGroupAuthorsEntity
+{
+  my ($line) = @_;
+  return ($line =~ m/the[[:space:]]\w+[[:space:]]authors/i) ? 1 : 0;
+}
+
+sub new
+{
+  my ($class, $f, $lines) = @_;
+
+  my (@records) = ();
+  my ($plain)   = 0;    # the lines without an exclude directive
+  foreach my ($line) (@{$lines}) {
+    last if ($plain > $MAXLINES && $#records >= $MINLINES - 1);
+
+    my ($r) = {'text' => $line};
+    $r->{'skip'}       = 1  if ($line =~ m+//.*[Kk]razy:skip+);
+    $r->{'excludeall'} = $1 if ($line =~ m+//.*?[Kk]razy:excludeall=(.*)+);
+    $r->{'exclude'}    = $1 if ($line =~ m+//.*?[Kk]razy:exclude=(.*)+);
+    $r->{'generated'}  = 1  if ($Generated->test($line));
+    $r->{'waived'} = 1
+      if ($line =~ m/ Public Domain/i || $line =~ m/(disclaims|waives) copyright/i);
+    $r->{'exempt'} = 1
+      if ($line =~ m/Public Domain/i
+      || $line =~ m/approved BSD License/i
+      || $line =~ m/(disclaims|waives) copyright/i
+      || $line =~ m/Redistribution and use is allowed/
+      || $line =~ m/Redistribution and use in source and binary forms/);
+    $r->{'spdxcopyright'} = 1 if ($line =~ m/SPDX-FileCopyrightText:/);
+    $r->{'spdxlicense'}   = 1 if ($line =~ m/SPDX-License-Identifier:/);
+    $r->{'copyright'}     = 1 if ($line =~ m/copyright/i && !$NotCopyright->test($line));
+
+    $plain++ if (!defined($r->{'exclude'}));
+    push(@records, $r);
+  }
+
+  return bless({'file' => $f, 'records' => \@records}, $class);
+}
+
+sub file
+{
+  my ($self) = @_;
+  return $self->{'file'};
+}
+
+sub records
+{
+  my ($self) = @_;
+  return $self->{'records'};
+}
+
+sub directive
+{
+  my ($self, $r, $prog) = @_;
+
+  return 'all'  if ($r->{'skip'} || (defined($r->{'excludeall'}) && $r->{'excludeall'} =~ m/$prog/));
+  return 'line' if (defined($r->{'exclude'}) && $r->{'exclude'} =~ m/$prog/);
+  return '';
+}
+
+sub licenseText
+{
+  my ($self) = @_;
+
+  if (!defined($self->{'license'})) {
+    my ($last) = $#{$self->{'records'}} < $MINLINES - 1 ? $#{$self->{'records'}} : $MINLINES - 1;
+    my ($text) = join('', map {$_->{'text'}} @{$self->{'records'}}[0 .. $last]);
+    $text =~ s/^\#//g;
+    $text =~ y/\t\n\r/   /;
+    $text =~ y/ A-Za-z.@0-9//cd;
+    $text =~ s/\s+/ /g;
+    $self->{'license'} = $text;
+  }
+  return $self->{'license'};
+}
+
+sub reuseInfo
+{
+  my ($self) = @_;
+
+  if (!exists($self->{'reuse'})) {
+    my ($absf) = abs_path($self->{'file'});
+    $self->{'reuse'} = defined($absf) ? &fileReuseInfo($absf) : undef;
+  }
+  return $self->{'reuse'};
+}
+
+sub missingLicenses
+{
+  my ($self, @expressions) = @_;
+
+  my ($absf) = abs_path($self->{'file'});
+  return () if (!defined($absf));
+  my ($dir) = &licensesDir(dirname($absf));
+  return () if (!$dir);
+
+  my (%seen) = ();
+  my (@missing) = ();
+  foreach my ($expr) (@expressions) {
+    foreach my ($id) (split(/[\s()]+/, $expr)) {
+      next if ($id eq '' || $id =~ m/^(AND|OR|WITH)$/i);
+      $id =~ s/\+$//;
+      next if ($seen{$id}++);
+      push(@missing, $id) if (!$Listing{$dir}{$id});
+    }
+  }
+  return @missing;
+}
+
+# the SPDX information of the file of the specified absolute path given by
+# a .license sidecar file or a REUSE.toml annotation, or undef
+sub fileReuseInfo
+{
+  my ($absf) = @_;
+
+  # the annotation of the nearest REUSE.toml matching the file, unless an
+  # outer one overrides it
+  my ($found) = undef;
+  foreach my ($toml) (&reuseTomls(dirname($absf))) {
+    my ($top) = dirname($toml);
+    my ($rel) = substr($absf, length($top) + 1);
+    my ($match) = undef;
+    foreach my ($annotation) (@{&tomlAnnotations($toml)}) {
+      $match = $annotation if (grep {$rel =~ $_} @{$annotation->{'paths'}});
+    }
+    next if (!$match);
+    $found = {%{$match}, 'source' => $toml} if (!$found || $match->{'precedence'} eq 'override');
+  }
+  return &reuseRecord($found) if ($found && $found->{'precedence'} eq 'override');
+
+  my ($sidecar) = "$absf.license";
+  if (-f $sidecar && open(my $fh, '<:encoding(UTF-8)', $sidecar)) {
+    my ($info) = {'source' => $sidecar, 'precedence' => 'override', 'copyrights' => [], 'licenses' => []};
+    while (<$fh>) {
+      push(@{$info->{'copyrights'}}, $1) if (m/SPDX-FileCopyrightText:\s*(.*?)\s*$/);
+      push(@{$info->{'licenses'}},   $1) if (m/SPDX-License-Identifier:\s*(.*?)\s*$/);
+    }
+    close($fh);
+    return $info;
+  }
+  return $found ? &reuseRecord($found) : undef;
+}
+
+# the information returned by reuseInfo() for the specified annotation
+sub reuseRecord
+{
+  my ($annotation) = @_;
+  return {map {$_ => $annotation->{$_}} qw(source precedence copyrights licenses)};
+}
+
+# return the REUSE.toml files of the specified directory and of the ones
+# above it, up to the top of the project, the nearest first
+sub reuseTomls
+{
+  my ($dir) = @_;
+
+  if (!$Dirs{$dir}) {
+    my (@tomls) = -f "$dir/REUSE.toml" ? ("$dir/REUSE.toml") : ();
+    my ($up) = dirname($dir);
+    push(@tomls, &reuseTomls($up)) if ($up ne $dir && !-e "$dir/.git");
+    $Dirs{$dir} = \@tomls;
+  }
+  return @{$Dirs{$dir}};
+}
+
+# return the LICENSES directory of the project holding the specified
+# directory, or '' if there is none
+sub licensesDir
+{
+  my ($dir) = @_;
+
+  if (!defined($Licenses{$dir})) {
+    if (-d "$dir/LICENSES") {
+      $Licenses{$dir} = "$dir/LICENSES";
+      my (%ids) = ();
+      if (opendir(my $dh, "$dir/LICENSES")) {
+        foreach my ($name) (readdir($dh)) {
+          next if ($name =~ m/^\./);
+          $ids{$name} = 1;
+          $ids{$1}    = 1 if ($name =~ m/^(.+)\.[^.]+$/);
+        }
+        closedir($dh);
+      }
+      $Listing{"$dir/LICENSES"} = \%ids;
+    } else {
+      my ($up) = dirname($dir);
+      $Licenses{$dir} = ($up ne $dir && !-e "$dir/.git") ? &licensesDir($up) : '';
+    }
+  }
+  return $Licenses{$dir};
+}
+
+# reuseDigest function: return a hash of everything outside the file of the
+# specified absolute path that the reuse information of the file depends on:
+# its .license sidecar file, the REUSE.toml files above it and the LICENSES
+# directory of the project
+sub reuseDigest
+{
+  my ($absf) = @_;
+  return '' if (!defined($absf));
+
+  my ($dir) = dirname($absf);
+  my (@parts) = map {$_ . "\0" . &slurp($_)} &reuseTomls($dir);
+  my ($licenses) = &licensesDir($dir);
+  push(@parts, join(",", sort keys %{$Listing{$licenses}})) if ($licenses);
+  push(@parts, &slurp("$absf.license")) if (-f "$absf.license");
+  return md5_hex(join("\0", @parts));
+}
+
+# the bytes of the specified file, or '' if it can't be read
+sub slurp
+{
+  my ($f) = @_;
+  open(my $fh, '<:raw', $f) or return '';
+  my ($content) = do {local $/; <$fh>};
+  close($fh);
+  return defined($content) ? $content : '';
+}
+
+#==============================================================================
+# REUSE.toml files: the [[annotations]] tables, with their path globs,
+# precedence, SPDX-FileCopyrightText and SPDX-License-Identifier keys.  This
+# is just enough TOML for those: strings, arrays of strings (spanning lines)
+# and comments.
+#==============================================================================
+
+# return the annotations of the specified REUSE.toml file, as hashes of
+# 'paths' (regular expressions matching the paths relative to the directory
+# of the file), 'precedence', 'copyrights' and 'licenses'
+sub tomlAnnotations
+{
+  my ($toml) = @_;
+
+  return $Tomls{$toml} if ($Tomls{$toml});
+  my (@annotations) = ();
+  my ($table)       = undef;    # the annotation being read
+  my ($pending)     = '';       # a line holding an array not closed yet
+  foreach my ($line) (split(/\n/, &slurp($toml))) {
+    utf8::decode($line);
+    $line = &tomlStrip($pending . $line);
+    $pending = '';
+    next if ($line =~ m/^\s*$/);
+    if ($line =~ m/^\s*\[\[\s*annotations\s*\]\]\s*$/) {
+      $table = {'paths' => [], 'precedence' => 'closest', 'copyrights' => [], 'licenses' => []};
+      push(@annotations, $table);
+      next;
+    }
+    if ($line =~ m/^\s*\[/) {
+      $table = undef;
+      next;
+    }
+    next if ($line !~ m/^\s*("[^"]*"|'[^']*'|[\w.-]+)\s*=\s*(.*)$/);
+    my ($key, $value) = ($1, $2);
+    if ($value =~ m/^\[/ && &tomlOpen($value)) {
+      $pending = "$line ";
+      next;
+    }
+    next if (!$table);
+    $key =~ s/^["'](.*)["']$/$1/;
+    my (@values) = &tomlStrings($value);
+    if ($key eq 'path') {
+      push(@{$table->{'paths'}}, map {&globRegex($_)} @values);
+    } elsif ($key eq 'precedence') {
+      $table->{'precedence'} = $values[0] if (@values && $values[0] =~ m/^(closest|aggregate|override)$/);
+    } elsif ($key eq 'SPDX-FileCopyrightText') {
+      push(@{$table->{'copyrights'}}, @values);
+    } elsif ($key eq 'SPDX-License-Identifier') {
+      push(@{$table->{'licenses'}}, @values);
+    }
+  }
+  $Tomls{$toml} = \@annotations;
+  return $Tomls{$toml};
+}
+
+# remove the comment ending the specified TOML line
+sub tomlStrip
+{
+  my ($line) = @_;
+  $line =~ s/^((?:[^"'#]|"(?:[^"\\]|\\.)*"|'[^']*')*)#.*$/$1/;
+  return $line;
+}
+
+# return true if the specified TOML array is not closed on its line
+sub tomlOpen
+{
+  my ($value) = @_;
+  $value =~ s/"(?:[^"\\]|\\.)*"|'[^']*'//g;
+  my ($open)  = ($value =~ tr/[//);
+  my ($close) = ($value =~ tr/]//);
+  return $open > $close;
+}
+
+# return the strings of the specified TOML value, a string or an array
+sub tomlStrings
+{
+  my ($value) = @_;
+
+  my (@strings) = ();
+  while ($value =~ m/"((?:[^"\\]|\\.)*)"|'([^']*)'/g) {
+    if (defined($2)) {
+      push(@strings, $2);
+    } else {
+      my ($s) = $1;
+      $s =~ s/\\u([0-9A-Fa-f]{4})|\\U([0-9A-Fa-f]{8})|\\(.)/
+        defined($1) ? chr(hex($1)) : defined($2) ? chr(hex($2)) :
+        $3 eq 'n' ? "\n" : $3 eq 't' ? "\t" : $3 eq 'r' ? "\r" : $3/ge;
+      push(@strings, $s);
+    }
+  }
+  return @strings;
+}
+
+# return the regular expression matching the paths of the specified REUSE.toml
+# glob: '*' stands for any characters but '/', '**' for any characters and
+# '\*' for an asterisk
+sub globRegex
+{
+  my ($glob) = @_;
+
+  my ($re) = '';
+  foreach my ($t) ($glob =~ m/(\\\\|\\\*|\*\*|\*|.)/gs) {
+    if ($t eq '**') {
+      $re .= '.*';
+    } elsif ($t eq '*') {
+      $re .= '[^/]*';
+    } elsif (length($t) == 2) {
+      $re .= quotemeta(substr($t, 1));
+    } else {
+      $re .= quotemeta($t);
+    }
+  }
+  return qr/^$re$/s;
+}
+
+# REUSE-IgnoreEnd
+
+1;
@@ -0,0 +1,370 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::IncGraph;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use Cwd 'abs_path';
+use Digest::MD5 qw(md5_hex);
+use File::Basename;
+use File::Find;
+use Krazy::Store;
+use Krazy::Source;
+use Krazy::Utils;
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(incgraphPath incgraphOpen incgraphScan incgraphData incgraphDigest incgraphSave incgraphReport);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# The include graph of a project: which C/C++ files include which, so the
+# checkers need not parse the #include lines of a file again, and so the
+# headers costing the most compile time can be told.
+#
+# incgraphScan($root) parses the #include lines of all the C/C++ files below
+# the top of the project in one pass.  A file is parsed again only when its
+# content hash changed; its modification time and size tell when the hash
+# must be computed again.  The includes are then resolved to the files of
+# the project, and the graph measured; the measures are kept until the
+# content of a file changes.  The graph is a store (see Krazy::Store), written
+# back at exit if anything changed.
+#
+# The graph is a hash holding:
+#   files:   absolute file path => {stamp, md5, includes}, the includes
+#            being {line, path, sep} hashes (see parseIncludes() in
+#            Krazy::Utils), in the order of the file
+#   metrics: the measures of the graph, made for the files of the digest
+#            (see incgraphDigest()), as a hash holding:
+#     digest:  the digest of the files measured
+#     targets: absolute file path => list of the absolute paths of the files
+#              its includes resolve to, in the order of the includes ('' for
+#              an include of a file not in the project)
+#     fanin:   absolute file path => the number of files including it
+#     fanout:  absolute file path => the number of project files it includes
+#     closure: absolute file path => the number of project files it pulls
+#              in, directly or not
+#     units:   absolute header path => the number of translation units (the
+#              files not headers) pulling it in, directly or not
+#     cycles:  the include cycles, as lists of absolute file paths
+#
+# The checkers query it through graphIncludes() in Krazy::Utils, or the
+# includes() of Krazy::Source.
+#==============================================================================
+
+my ($FORMAT) = 1;     # the version of the graph layout
+my ($Path)   = '';    # the graph file, if in use
+my ($Dirty)  = 0;     # true if the graph needs saving
+my (%Graph)  = ('format' => $FORMAT, 'files' => {}, 'metrics' => {});
+
+# return the default graph file of the project at the specified top
+# directory, under the XDG cache directory
+sub incgraphPath
+{
+  my ($root) = @_;
+  return &storePath('incgraph', md5_hex(abs_path($root) || $root));
+}
+
+# start using the graph in the specified file, which may not exist yet
+sub incgraphOpen
+{
+  my ($path) = @_;
+
+  $Path = $path;
+  my ($g) = &storeOpen($path, $FORMAT);
+  %Graph = %{$g} if ($g);
+}
+
+# parse the includes of the C/C++ files below the specified directory, taking
+# the content of the files krazy2 read already from the hash of absolute
+# paths to content references, and measure the graph.  Returns the number of
+# files in the graph and the number of those parsed again.
+sub incgraphScan
+{
+  my ($root, $known) = @_;
+  $known = {} if (!$known);
+
+  my (%seen)   = ();
+  my ($parsed) = 0;
+  find(
+    {
+      'preprocess' => sub {
+        return grep {!m/^\./} @_;    # no .git and the like
+      },
+      'wanted' => sub {
+        return if (!-f $_ || &fileType($_) ne "c++");
+        my ($absf) = $File::Find::name;
+        my (@st) = stat(_);
+        my ($stamp) = "$st[9]:$st[7]";
+        $seen{$absf} = 1;
+        my ($entry) = $Graph{'files'}{$absf};
+        return if ($entry && $entry->{'stamp'} eq $stamp);
+
+        my ($ref) = $known->{$absf};
+        if (!$ref) {
+          open my $fh, '<:raw', $_ or return;
+          my ($content) = do {local $/; <$fh>};
+          close($fh);
+          $content = "" if (!defined($content));
+          $ref = \$content;
+        }
+        my ($md5) = md5_hex(${$ref});
+        if (!$entry || $entry->{'md5'} ne $md5) {
+          $entry = {'md5' => $md5, 'includes' => [&parseIncludes(Krazy::Source->new($absf, $ref)->noIfZeroLines())]};
+          $parsed++;
+        }
+        $entry->{'stamp'} = $stamp;
+        $Graph{'files'}{$absf} = $entry;
+        $Dirty = 1;
+      },
+      'no_chdir' => 0,
+    },
+    abs_path($root) || $root
+  );
+
+  foreach my ($absf) (keys %{$Graph{'files'}}) {
+    next if ($seen{$absf});
+    delete($Graph{'files'}{$absf});
+    $Dirty = 1;
+  }
+
+  my ($digest) = &incgraphDigest();
+  if (!$Graph{'metrics'}{'digest'} || $Graph{'metrics'}{'digest'} ne $digest) {
+    $Graph{'metrics'} = &measure();
+    $Graph{'metrics'}{'digest'} = $digest;
+    $Dirty = 1;
+  }
+  return (scalar(keys %seen), $parsed);
+}
+
+# return the path with the "." and ".." components taken out
+sub cleanPath
+{
+  my ($p) = @_;
+  my (@parts) = ();
+  foreach my ($c) (split(m+/+, $p)) {
+    next if ($c eq '.' || ($c eq '' && $#parts >= 0));
+    if ($c eq '..' && $#parts >= 0 && $parts[-1] ne '..' && $parts[-1] ne '') {
+      pop(@parts);
+    } else {
+      push(@parts, $c);
+    }
+  }
+  return join("/", @parts);
+}
+
+# return the length of the common leading part of two paths
+sub commonLength
+{
+  my ($p, $q) = @_;
+  my ($n) = 0;
+  $n++ while ($n < length($p) && $n < length($q) && substr($p, $n, 1) eq substr($q, $n, 1));
+  return $n;
+}
+
+# return the absolute path of the project file the include of the specified
+# path by the specified file resolves to, or '' if none: the file next to
+# the including file, else the file whose path ends with the include path
+# closest to the including file.  The index holds the files by base name.
+sub resolve
+{
+  my ($absf, $path, $byName) = @_;
+
+  return '' if ($path eq '' || $path =~ m+^/+);
+  my ($next) = &cleanPath(dirname($absf) . "/$path");
+  return $next if ($Graph{'files'}{$next});
+
+  my ($tail) = &cleanPath($path);
+  $tail =~ s:^(\.\./)+::;
+  my ($best, $bestLen) = ('', -1);
+  foreach my ($cand) (@{$byName->{basename($tail)} || []}) {
+    next if ($cand ne $tail && substr($cand, -length($tail) - 1) ne "/$tail");
+    my ($len) = &commonLength($cand, $absf);
+    ($best, $bestLen) = ($cand, $len) if ($len > $bestLen);
+  }
+  return $best;
+}
+
+# return the measures of the graph, as described above
+sub measure
+{
+  my (@nodes) = sort keys %{$Graph{'files'}};
+  my (%index) = map {$nodes[$_] => $_} 0 .. $#nodes;
+  my (%byName) = ();
+  push(@{$byName{basename($_)}}, $_) foreach (@nodes);
+
+  # resolve the includes into edges
+  my (%targets, %fanin, %fanout);
+  my (@edges) = ();
+  foreach my ($n) (0 .. $#nodes) {
+    my ($absf) = $nodes[$n];
+    my (@t) = map {&resolve($absf, $_->{'path'}, \%byName)} @{$Graph{'files'}{$absf}{'includes'}};
+    $targets{$absf} = \@t;
+    my (%out) = map {$index{$_} => 1} grep {$_ ne ''} @t;
+    $edges[$n] = [sort {$a <=> $b} keys %out];
+    $fanout{$absf} = scalar(@{$edges[$n]});
+    $fanin{$nodes[$_]}++ foreach (@{$edges[$n]});
+  }
+
+  # the strongly connected components (Tarjan), without recursion; each
+  # component comes after the components it reaches
+  my (@comp)  = (-1) x scalar(@nodes);
+  my (@order) = (-1) x scalar(@nodes);
+  my (@low)   = (0) x scalar(@nodes);
+  my (@onStack, @stack, @comps);
+  my ($counter) = 0;
+  foreach my ($start) (0 .. $#nodes) {
+    next if ($order[$start] >= 0);
+    my (@work) = ([$start, 0]);
+    $order[$start] = $low[$start] = $counter++;
+    push(@stack, $start);
+    $onStack[$start] = 1;
+    while (@work) {
+      my ($frame) = $work[-1];
+      my ($v) = $frame->[0];
+      if ($frame->[1] <= $#{$edges[$v]}) {
+        my ($w) = $edges[$v][$frame->[1]++];
+        if ($order[$w] < 0) {
+          $order[$w] = $low[$w] = $counter++;
+          push(@stack, $w);
+          $onStack[$w] = 1;
+          push(@work, [$w, 0]);
+        } elsif ($onStack[$w]) {
+          $low[$v] = $order[$w] if ($order[$w] < $low[$v]);
+        }
+        next;
+      }
+      pop(@work);
+      if (@work) {
+        my ($u) = $work[-1][0];
+        $low[$u] = $low[$v] if ($low[$v] < $low[$u]);
+      }
+      if ($low[$v] == $order[$v]) {
+        my (@members) = ();
+        my ($w);
+        do {
+          $w = pop(@stack);
+          $onStack[$w] = 0;
+          $comp[$w] = scalar(@comps);
+          push(@members, $w);
+        } while ($w != $v);
+        push(@comps, \@members);
+      }
+    }
+  }
+
+  # what each component pulls in, itself included, as bit vectors of the nodes
+  my (@reach) = ();
+  my (@cycles) = ();
+  foreach my ($c) (0 .. $#comps) {
+    my ($bits) = '';
+    my ($self) = 0;
+    foreach my ($v) (@{$comps[$c]}) {
+      vec($bits, $v, 1) = 1;
+      foreach my ($w) (@{$edges[$v]}) {
+        $self = 1 if ($w == $v);
+        $bits |= $reach[$comp[$w]] if ($comp[$w] != $c);
+      }
+    }
+    $reach[$c] = $bits;
+    push(@cycles, [map {$nodes[$_]} sort {$a <=> $b} @{$comps[$c]}]) if ($#{$comps[$c]} > 0 || $self);
+  }
+
+  my (%closure, %units);
+  foreach my ($n) (0 .. $#nodes) {
+    my ($bits) = $reach[$comp[$n]];
+    my ($size) = unpack("%32b*", $bits);
+    $size--;    # not counting itself
+    $closure{$nodes[$n]} = $size;
+    next if (&isCInclude($nodes[$n]));
+
+    my ($set) = unpack("b*", $bits);
+    for (my $i = index($set, '1') ; $i >= 0 ; $i = index($set, '1', $i + 1)) {
+      $units{$nodes[$i]}++ if ($i != $n);
+    }
+  }
+
+  return {
+    'targets' => \%targets,
+    'fanin'   => \%fanin,
+    'fanout'  => \%fanout,
+    'closure' => \%closure,
+    'units'   => \%units,
+    'cycles'  => \@cycles,
+  };
+}
+
+# return the graph, as described above
+sub incgraphData
+{
+  return \%Graph;
+}
+
+# return a hash of the content of all the files in the graph, which changes
+# whenever any of them changes
+sub incgraphDigest
+{
+  return md5_hex(join("\n", map {"$_ $Graph{'files'}{$_}{'md5'}"} sort keys %{$Graph{'files'}}));
+}
+
+# print to stderr the specified number of headers pulled in by the most
+# translation units, with their measures, and the include cycles.
+# The paths are shown relative to the specified top directory.
+sub incgraphReport
+{
+  my ($top, $root) = @_;
+  my ($m) = $Graph{'metrics'};
+  my ($prefix) = (abs_path($root) || $root) . "/";
+  my ($rel) = sub {
+    my ($p) = @_;
+    return substr($p, 0, length($prefix)) eq $prefix ? substr($p, length($prefix)) : $p;
+  };
+
+  my (@files)   = keys %{$Graph{'files'}};
+  my (@headers) = grep {&isCInclude($_)} @files;
+  my ($nedges)  = 0;
+  $nedges += $_ foreach (values %{$m->{'fanout'}});
+  printf STDERR ("Include graph: %d files (%d headers), %d includes between them, %d include cycles\n",
+    scalar(@files), scalar(@headers), $nedges, scalar(@{$m->{'cycles'}}));
+
+  my (@costly) = sort {
+         ($m->{'units'}{$b} || 0) <=> ($m->{'units'}{$a} || 0)
+      || ($m->{'closure'}{$b} || 0) <=> ($m->{'closure'}{$a} || 0)
+      || $a cmp $b
+  } grep {$m->{'units'}{$_}} @headers;
+  $#costly = $top - 1 if ($#costly >= $top);
+  print STDERR "Headers pulled in by the most translation units:\n";
+  printf STDERR ("  %6s %6s %7s %7s  %s\n", "units", "fanin", "fanout", "closure", "header");
+  foreach my ($h) (@costly) {
+    printf STDERR ("  %6d %6d %7d %7d  %s\n",
+      $m->{'units'}{$h}, $m->{'fanin'}{$h} || 0, $m->{'fanout'}{$h} || 0, $m->{'closure'}{$h} || 0, &{$rel}($h));
+  }
+
+  if (@{$m->{'cycles'}}) {
+    print STDERR "Include cycles:\n";
+    foreach my ($cycle) (@{$m->{'cycles'}}) {
+      print STDERR "  " . join(" ", map {&{$rel}($_)} @{$cycle}) . "\n";
+    }
+  }
+}
+
+# write the graph back to its file, if anything changed.
+# returns 1 on success (or when there was nothing to write), 0 otherwise.
+sub incgraphSave
+{
+  return 1 if (!$Path || !$Dirty);
+  return 0 if (!&storeSave($Path, \%Graph));
+  $Dirty = 0;
+  return 1;
+}
+
+&storeAtExit(\&incgraphSave);
+
+1;
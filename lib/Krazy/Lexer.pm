@@ -0,0 +1,369 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Lexer;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(lexC scopesC scopeLines scopeBases);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# A tokenizer for C/C++ source, and a scope tracker working on its tokens,
+# for the checkers that need to know which class and which access section
+# a line belongs to.
+#
+# lexC($text) returns a reference to the array of the tokens of the text,
+# made in one pass.  Each token is a hash holding:
+#   type:  ident, number, string, char, punct, directive or comment
+#   text:  the text of the token (a directive holds its whole logical line)
+#   line:  the line number of the start of the token, from 1
+#   col:   the column of the start of the token, from 1
+#   depth: the number of braces the token is enclosed in
+#   match: for a bracket ( [ { ) ] }, the index of its partner, if any
+#
+# scopesC($tokens) returns a reference to the array of the class, struct,
+# union and namespace definitions, in the order they start.  Each scope is a
+# hash holding:
+#   kind:     class, struct, union or namespace
+#   name:     its name, possibly qualified (empty for an anonymous one)
+#   line:     the line of its keyword
+#   open, close: the indexes of its braces (close is undef if unmatched)
+#   endLine:  the line of its closing brace
+#   parent:   the index of the enclosing scope, or -1
+#   head:     the text of the tokens from the keyword to the opening brace
+#   exported: true if an export macro (like FOO_EXPORT) is in the head
+#   template: true if the definition is a template
+#   sections: the access labels of a class, struct or union, as a list of
+#             [line, access] pairs; the access is public, protected,
+#             private, signals, or the access followed by " slots"
+#
+# scopeLines($scopes, $i, $tokens) returns the lines of scope number $i that
+# hold tokens of its body between the braces (not of a nested class, struct
+# or union), as a list of [line, access, first] triples: the access in effect
+# on the line and the index of the first token of the body on the line.
+#
+# scopeBases($tokens, $scope) returns the names of the base classes in the
+# head of a scope, without qualification nor template arguments.
+#==============================================================================
+
+# the punctuators, longest first
+my ($PUNCT) = qr{
+    \.\.\. | <<= | >>= | <=> | ->\* | ::
+  | -> | \+\+ | -- | << | >> | <= | >= | == | != | && | \|\| | \.\*
+  | [-+*/%^&|]= | \#\#
+  | [^\s\w]
+}x;
+
+my (%Closer) = (')' => '(', ']' => '[', '}' => '{');
+
+sub lexC
+{
+  my ($text) = @_;
+
+  my (@tokens) = ();
+  my (@open)   = ();    # the indexes of the open brackets
+  my ($line)   = 1;     # the line at pos()
+  my ($bol)    = 0;     # the offset of the start of that line
+  my ($first)  = 1;     # true if only white space is before pos() on the line
+  my ($depth)  = 0;
+
+  pos($text) = 0;
+  while (1) {
+
+    # white space, newlines and line splices
+    next if ($text =~ m/\G[ \t\f\r\x0b]+/gc);
+    if ($text =~ m/\G(\\?)\n/gc) {
+      $line++;
+      $bol = pos($text);
+      $first = 1 if (!$1);
+      next;
+    }
+    my ($start) = pos($text);
+    last if ($start >= length($text));
+
+    my ($type);
+    if ($first && $text =~ m/\G#(?:[^\\\n]|\\.)*+/sgc) {
+      $type = 'directive';
+    } elsif ($text =~ m{\G//(?:[^\\\n]|\\.)*+}sgc || $text =~ m{\G/\*.*?(?:\*/|\z)}sgc) {
+      $type = 'comment';
+    } elsif ($text =~ m/\G(?:u8|[uUL])?R"([^()\\\s"]{0,16})\(.*?\)\1"/sgc) {
+      $type = 'string';
+    } elsif ($text =~ m/\G(?:u8|[uUL])?"(?:[^"\\\n]|\\.)*+"?/sgc) {
+      $type = 'string';
+    } elsif ($text =~ m/\G(?:u8|[uUL])?'(?:[^'\\\n]|\\.)*+'?/sgc) {
+      $type = 'char';
+    } elsif ($text =~ m/\G\.?[0-9](?:[eEpP][-+]|'[0-9A-Za-z_]|[0-9A-Za-z_.])*+/gc) {
+      $type = 'number';
+    } elsif ($text =~ m/\G[A-Za-z_\$][\w\$]*+/gc) {
+      $type = 'ident';
+    } elsif ($text =~ m/\G$PUNCT/gc) {
+      $type = 'punct';
+    } else {
+      pos($text) = $start + 1;
+      $type = 'punct';
+    }
+    $first = 0;
+
+    my ($t) = substr($text, $start, pos($text) - $start);
+    my ($token) = {'type' => $type, 'text' => $t, 'line' => $line, 'col' => $start - $bol + 1};
+    if ($type eq 'punct' && $t =~ m/^[\(\[\{]$/) {
+      $token->{'depth'} = $depth;
+      $depth++ if ($t eq '{');
+      push(@open, scalar(@tokens));
+    } elsif ($type eq 'punct' && $Closer{$t}) {
+
+      # close the nearest open bracket of the same kind, dropping the unclosed
+      # brackets opened after it
+      for (my $i = $#open ; $i >= 0 ; $i--) {
+        my ($o) = $open[$i];
+        next if ($tokens[$o]->{'text'} ne $Closer{$t});
+        foreach my ($u) (splice(@open, $i)) {
+          $depth-- if ($tokens[$u]->{'text'} eq '{');
+        }
+        $token->{'match'} = $o;
+        $tokens[$o]->{'match'} = scalar(@tokens);
+        last;
+      }
+      $token->{'depth'} = $depth;
+    } else {
+      $token->{'depth'} = $depth;
+    }
+    push(@tokens, $token);
+
+    # the lines spanned by the token
+    my ($nl) = ($t =~ tr/\n//);
+    if ($nl) {
+      $line += $nl;
+      $bol = $start + rindex($t, "\n") + 1;
+    }
+  }
+  return \@tokens;
+}
+
+# return the index of the significant (not comment) token before $i, or -1
+sub prevToken
+{
+  my ($tokens, $i) = @_;
+  $i--;
+  $i-- while ($i >= 0 && $tokens->[$i]->{'type'} eq 'comment');
+  return $i;
+}
+
+# return true if the token before $i ends a template parameter list that
+# follows the "template" keyword
+sub afterTemplate
+{
+  my ($tokens, $i) = @_;
+
+  my ($j) = &prevToken($tokens, $i);
+  return 0 if ($j < 0 || $tokens->[$j]->{'text'} !~ m/^>>?$/);
+  my ($angles) = 0;
+  for (; $j >= 0 ; $j--) {
+    my ($t) = $tokens->[$j]->{'text'};
+    if ($t eq '>') {
+      $angles++;
+    } elsif ($t eq '>>') {
+      $angles += 2;
+    } elsif ($t eq '<') {
+      $angles--;
+      last if ($angles <= 0);
+    } elsif ($t eq ';' || $t eq '{' || $t eq '}') {
+      return 0;
+    }
+  }
+  $j = &prevToken($tokens, $j);
+  return ($j >= 0 && $tokens->[$j]->{'text'} eq 'template') ? 1 : 0;
+}
+
+# return the index of the opening brace of the definition starting with the
+# keyword at $i and the tokens of its head before any base clause, or -1 if
+# the keyword does not start a definition
+sub findOpen
+{
+  my ($tokens, $i) = @_;
+
+  my (@name) = ();
+  my ($bases) = 0;    # true in the base clause
+  my ($angles) = 0;
+  for (my $j = $i + 1 ; $j <= $#{$tokens} ; $j++) {
+    my ($tok) = $tokens->[$j];
+    my ($type, $t) = ($tok->{'type'}, $tok->{'text'});
+    next if ($type eq 'comment');
+    return ($j, @name) if ($t eq '{' && !$angles);
+    return -1 if ($t eq ';' || $t eq '}' || $type eq 'directive');
+    if ($bases) {
+      $j = $tok->{'match'} if (($t eq '(' || $t eq '[') && defined($tok->{'match'}));
+      next;
+    }
+    my ($macro) = ($#name >= 0 && $name[-1] =~ m/^([A-Z][A-Z0-9_]*|alignas|__declspec|__attribute__)$/);
+    if (($t eq '(' || $t eq '[') && defined($tok->{'match'}) && ($angles || $macro)) {
+
+      # an expression in the arguments of a specialization, or the arguments
+      # of a macro (like an export macro) or of alignas
+      $j = $tok->{'match'};
+    } elsif ($angles) {
+
+      # in the arguments of a specialization
+      $angles++ if ($t eq '<');
+      $angles-- if ($t eq '>');
+      $angles -= 2 if ($t eq '>>');
+      $angles = 0 if ($angles < 0);
+    } elsif ($t eq '<') {
+      $angles = 1;
+    } elsif ($t eq ':') {
+      $bases = 1;
+    } elsif ($t eq '[' && defined($tok->{'match'})) {
+
+      # an attribute
+      $j = $tok->{'match'};
+    } elsif ($type eq 'ident' || $t eq '::') {
+      push(@name, $t) if ($t ne 'final');
+    } else {
+      return -1;
+    }
+  }
+  return -1;
+}
+
+sub scopesC
+{
+  my ($tokens) = @_;
+
+  my (@scopes) = ();
+  my (@stack)  = ();    # the indexes of the scopes enclosing the current token
+  for (my $i = 0 ; $i <= $#{$tokens} ; $i++) {
+    my ($tok) = $tokens->[$i];
+    pop(@stack) while ($#stack >= 0 && defined($scopes[$stack[-1]]->{'close'}) && $i > $scopes[$stack[-1]]->{'close'});
+    next if ($tok->{'type'} ne 'ident');
+    my ($t) = $tok->{'text'};
+
+    # an access label of the innermost class
+    if ($t =~ m/^(public|protected|private|signals|Q_SIGNALS)$/ && $#stack >= 0) {
+      my ($scope) = $scopes[$stack[-1]];
+      next if ($scope->{'kind'} eq 'namespace' || $tok->{'depth'} != $tokens->[$scope->{'open'}]->{'depth'} + 1);
+      my ($access) = $t eq 'Q_SIGNALS' ? 'signals' : $t;
+      my ($j) = $i + 1;
+      $j++ while ($j <= $#{$tokens} && $tokens->[$j]->{'type'} eq 'comment');
+      if ($j <= $#{$tokens} && $access ne 'signals' && $tokens->[$j]->{'text'} =~ m/^(slots|Q_SLOTS)$/) {
+        $access .= " slots";
+        $j++;
+      }
+      push(@{$scope->{'sections'}}, [$tok->{'line'}, $access])
+        if ($j <= $#{$tokens} && $tokens->[$j]->{'text'} eq ':');
+      next;
+    }
+
+    next if ($t !~ m/^(class|struct|union|namespace)$/);
+    my ($p) = &prevToken($tokens, $i);
+    next if ($p >= 0 && $tokens->[$p]->{'text'} =~ m/^(enum|friend|typename|<|,|\(|::)$/);
+    my ($open, @name) = &findOpen($tokens, $i);
+    next if ($open < 0);
+
+    # the name is the trailing qualified identifier of the head
+    my ($name) = ($#name >= 0 && $name[-1] ne '::') ? pop(@name) : "";
+    while ($name ne "" && $#name >= 1 && $name[-1] eq '::' && $name[-2] ne '::') {
+      $name = pop(@name) . $name;
+      $name = pop(@name) . $name;
+    }
+    my ($close) = $tokens->[$open]->{'match'};
+    my ($head) = join(" ", map {$_->{'text'}} grep {$_->{'type'} ne 'comment'} @{$tokens}[$i .. $open - 1]);
+    push(
+      @scopes,
+      {
+        'kind'     => $t,
+        'name'     => $name,
+        'line'     => $tok->{'line'},
+        'open'     => $open,
+        'close'    => $close,
+        'endLine'  => defined($close) ? $tokens->[$close]->{'line'} : $tokens->[-1]->{'line'},
+        'parent'   => $#stack >= 0 ? $stack[-1] : -1,
+        'head'     => $head,
+        'exported' => ($head =~ m/_EXPORT/) ? 1 : 0,
+        'template' => &afterTemplate($tokens, $i),
+        'sections' => [],
+      }
+    );
+    push(@stack, $#scopes);
+    $i = $open;
+  }
+  return \@scopes;
+}
+
+sub scopeLines
+{
+  my ($scopes, $n, $tokens) = @_;
+
+  my ($scope) = $scopes->[$n];
+  my ($last) = defined($scope->{'close'}) ? $scope->{'close'} - 1 : $#{$tokens};
+
+  # the token ranges of the nested classes, left out
+  my (@skip) = ();
+  foreach my ($s) (@{$scopes}[$n + 1 .. $#{$scopes}]) {
+    last if ($s->{'open'} > $last);
+    next if ($s->{'kind'} eq 'namespace' || $s->{'parent'} != $n);
+    push(@skip, [$s->{'open'}, defined($s->{'close'}) ? $s->{'close'} : $last]);
+  }
+
+  my (@sections) = @{$scope->{'sections'}};
+  my ($access) = $scope->{'kind'} eq 'class' ? 'private' : 'public';
+  my (@lines) = ();
+  my ($prev) = 0;
+  for (my $i = $scope->{'open'} + 1 ; $i <= $last ; $i++) {
+    if ($#skip >= 0 && $i >= $skip[0]->[0]) {
+      $i = $skip[0]->[1];
+      shift(@skip);
+      next;
+    }
+    my ($l) = $tokens->[$i]->{'line'};
+    next if ($l == $prev);
+    $access = shift(@sections)->[1] while ($#sections >= 0 && $sections[0]->[0] <= $l);
+    push(@lines, [$l, $access, $i]);
+    $prev = $l;
+  }
+  return @lines;
+}
+
+sub scopeBases
+{
+  my ($tokens, $scope) = @_;
+
+  return () if ($scope->{'head'} !~ m/ : /);
+  my (@bases)  = ();
+  my ($name)   = "";
+  my ($angles) = 0;
+  my ($start)  = $scope->{'open'} - 1;
+  $start-- while ($start > 0 && $tokens->[$start]->{'text'} ne ':');
+  for (my $i = $start + 1 ; $i < $scope->{'open'} ; $i++) {
+    my ($tok) = $tokens->[$i];
+    my ($t) = $tok->{'text'};
+    next if ($tok->{'type'} eq 'comment');
+    if ($t eq '<') {
+      $angles++;
+    } elsif ($t eq '>') {
+      $angles--;
+    } elsif ($t eq '>>') {
+      $angles -= 2;
+    } elsif ($t eq '(' && defined($tok->{'match'})) {
+      $i = $tok->{'match'};
+    } elsif ($t eq ',' && $angles <= 0) {
+      push(@bases, $name) if ($name ne "");
+      $name = "";
+    } elsif ($angles <= 0 && $tok->{'type'} eq 'ident' && $t !~ m/^(public|protected|private|virtual)$/) {
+      $name = $t;    # the last component of a qualified name
+    }
+  }
+  push(@bases, $name) if ($name ne "");
+  return @bases;
+}
+
+1;
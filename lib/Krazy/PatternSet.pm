@@ -0,0 +1,148 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::PatternSet;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw();
+@EXPORT_OK = qw();
+
+#==============================================================================
+# A set of strings or regular expressions, compiled once and matched at once.
+#
+# Checkers often test a string against a long list of patterns, as in
+# ($s eq "QtCore" || $s eq "QtGui" || ...) or a series of "next if ($line =~ ...)"
+# lines, which costs a comparison or a regular expression match per member for
+# the strings that match none of them, the most common case.  A pattern set
+# makes that a single hash lookup or a single match:
+#   Krazy::PatternSet->new(\@members, %options) returns the set of the members,
+#   with the options:
+#     'exact' => 1:   the members are strings, which match a string equal to them
+#     'literal' => 1: the members are strings, which match a string holding them
+#     'icase' => 1:   case is ignored
+#   By default, the members are regular expressions, as strings or as qr//
+#   objects (which keep their own flags, so 'icase' does not apply to them).
+#
+#   $set->test($s):  returns true if any member matches $s
+#   $set->which($s): returns the index of the first member matching $s, in the
+#                    order of the members, or -1 if none does
+#   $set->match($s): returns the first member matching $s, or undef if none does
+#
+# An exact set is a hash.  The other sets are a single alternation of their
+# members, which perl compiles into a trie where the members start with literal
+# text; which() and match() only try the members one by one, in order, after
+# that alternation matched.  Perl makes a much slower trie when case is
+# ignored, or when a member holds a capturing group, so the groups are made
+# non-capturing in the alternation, and the members of a set ignoring case are
+# lowercased and matched, without ignoring case, against the lowercased string,
+# unless lowercasing would change what they match (as with \S, \x41 or [A-Z]).
+# Regular expressions holding back-references can't be joined (the group
+# numbers would change), so such a set tries its members one by one.
+# A few literal strings are still found faster by separate matches, which
+# perl makes with the Boyer-Moore algorithm, than by a set of them.
+#==============================================================================
+
+sub new
+{
+  my ($class, $members, %options) = @_;
+
+  my ($self) = bless(
+    {
+      'members' => [@{$members}],
+      'exact'   => $options{'exact'}   ? 1 : 0,
+      'literal' => $options{'literal'} ? 1 : 0,
+      'icase'   => $options{'icase'}   ? 1 : 0,
+    },
+    $class
+  );
+
+  my (@members) = @{$self->{'members'}};
+  if ($self->{'exact'}) {
+    my (%index) = ();
+    for (my $i = $#members ; $i >= 0 ; $i--) {
+      $index{$self->{'icase'} ? lc($members[$i]) : $members[$i]} = $i;
+    }
+    $self->{'index'} = \%index;
+    return $self;
+  }
+
+  my (@res) = $self->{'literal'} ? map {quotemeta($_)} @members : @members;
+  my ($flags) = $self->{'icase'} ? 'i' : '';
+  $self->{'res'} = [map {qr/(?$flags:$_)/} @res];
+  return $self if (grep {m/\\[1-9]|\\g\{?-?\d|\\k[<{']/} @res);
+
+  # the alternations of the members, lowercased or not, without capturing
+  # groups, which would keep perl from making a trie
+  my (@fold) = ();
+  my (@any)  = ();
+  foreach my ($i) (0 .. $#res) {
+    my ($re) = $res[$i];
+    $re =~ s/(?<!\\)\((?!\?)/(?:/g if ($re !~ m/\[/);
+    if ($self->{'icase'} && ($self->{'literal'} || $re !~ m/\\[A-Zcopx0-9]|\(\?[^:]|\[[^\]]*[A-Z]/)) {
+      push(@fold, $self->{'literal'} ? quotemeta(lc($members[$i])) : lc($re));
+    } else {
+      push(@any, $re);
+    }
+  }
+  $self->{'joined'} = 1;
+  if ($#fold >= 0) {
+    my ($alt) = join("|", @fold);
+    $self->{'fold'} = qr/$alt/;
+  }
+  if ($#any >= 0) {
+    my ($alt) = join("|", @any);
+    $self->{'any'} = qr/(?$flags:$alt)/;
+  }
+  return $self;
+}
+
+sub members
+{
+  my ($self) = @_;
+  return @{$self->{'members'}};
+}
+
+sub test
+{
+  my ($self, $s) = @_;
+
+  return exists($self->{'index'}{$self->{'icase'} ? lc($s) : $s}) ? 1 : 0 if ($self->{'exact'});
+  return ($self->which($s) >= 0) ? 1 : 0 if (!$self->{'joined'});
+  return 1 if ($self->{'fold'} && lc($s) =~ $self->{'fold'});
+  return ($self->{'any'} && $s =~ $self->{'any'}) ? 1 : 0;
+}
+
+sub which
+{
+  my ($self, $s) = @_;
+
+  if ($self->{'exact'}) {
+    my ($i) = $self->{'index'}{$self->{'icase'} ? lc($s) : $s};
+    return defined($i) ? $i : -1;
+  }
+  return -1 if ($self->{'joined'} && !$self->test($s));
+  my ($res) = $self->{'res'};
+  for (my $i = 0 ; $i <= $#{$res} ; $i++) {
+    return $i if ($s =~ $res->[$i]);
+  }
+  return -1;
+}
+
+sub match
+{
+  my ($self, $s) = @_;
+  my ($i) = $self->which($s);
+  return ($i >= 0) ? $self->{'members'}[$i] : undef;
+}
+
+1;
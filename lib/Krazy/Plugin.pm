@@ -0,0 +1,360 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Plugin;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use Cwd 'abs_path';
+use FindBin;
+use Krazy::Utils;
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(pluginMeta pluginFilter pluginTriggers triggerScanner loadPlugin runPlugin resultText);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# Base class for checker programs that can run inside krazy2.
+#
+# A plugin using this API is still an executable program that follows the
+# usual plugin rules, but krazy2 can also load it once into its own
+# interpreter and call its check() method for each file to process,
+# saving a perl startup for every file.  When run as a program, the plugin
+# also supports the --batch option (see runBatch() in Krazy::Utils).
+#
+# To use the API a plugin must:
+#   1. declare a package of its own, derived from Krazy::Plugin
+#   2. implement the name(), version(), help(), explain() and check() methods
+#   3. end with the statement: __PACKAGE__->run();
+#   4. announce itself with the comment line: # krazy-meta: api=plugin
+#
+# check($file, \%ctx) is called with the file to test and a context hash
+# holding the krazy2 settings (priority, strict, checksets, quiet and verbose).
+# It must return the number of issues found followed by the output lines
+# (without newlines) that the program would print before the ISSUES=N line.
+# The "okay" line is handled by this class.
+#
+# Expensive set-up, like reading a dictionary from __DATA__, belongs in the
+# prepare() method, which krazy2 calls once right after loading the plugin
+# (checks may run in forked worker processes sharing what prepare() built).
+#
+# See plugins/TEMPLATE.pl for an example.
+#
+# A plugin that only looks for regular expressions in each line can be made
+# of line rules instead, with Krazy::Rules (see plugins/TEMPLATE.rules).
+#==============================================================================
+
+my ($Hosted) = 0;     # true while krazy2 is loading a plugin
+my ($Loaded) = '';    # the class of the plugin that was just loaded
+my (%Plugins);        # loaded plugin objects, by real path
+
+sub new
+{
+  my ($class) = @_;
+  my ($self) = {};
+  return bless($self, $class);
+}
+
+sub name    {return "<plugin>";}
+sub version {return "<version>";}
+sub help    {return "<one-line help message>";}
+sub explain {return "<describe problem with solution.>";}
+
+sub prepare
+{
+  my ($self) = @_;
+}
+
+sub check
+{
+  my ($self, $f, $ctx) = @_;
+  return (0);
+}
+
+# run the plugin as a stand-alone program, or register it if being loaded by krazy2
+sub run
+{
+  my ($class) = @_;
+
+  if ($Hosted) {
+    $Loaded = $class;
+    return 1;
+  }
+
+  &parseArgs();
+
+  if (&helpArg()) {
+    print $class->help() . "\n";
+    Exit 0;
+  }
+  if (&versionArg()) {
+    print $class->name() . ", version " . $class->version() . "\n";
+    Exit 0;
+  }
+  if (&explainArg()) {
+    print $class->explain() . "\n";
+    Exit 0;
+  }
+  if (&batchArg()) {
+    my ($plugin) = $class->new();
+    my ($ctx)    = &argsContext();
+    $plugin->prepare();
+    &runBatch(
+      sub {
+        my ($issues, $out) = &checkFile($plugin, $_[0], $ctx);
+        print $out;
+        return $issues;
+      }
+    );
+  }
+  if ($#ARGV != 0) {
+    print $class->help() . "\n";
+    Exit 0;
+  }
+
+  my ($issues, $out) = &checkFile($class->new(), $ARGV[0], &argsContext());
+  print $out;
+  Exit $issues;
+}
+
+# the krazy2 settings the plugin was started with, as a context hash
+sub argsContext
+{
+  return {
+    'priority'  => &priorityArg(),
+    'strict'    => &strictArg(),
+    'checksets' => &checkSetsArg(),
+    'quiet'     => &quietArg(),
+    'verbose'   => &verboseArg(),
+  };
+}
+
+# check a file, returning the number of issues and the program output text
+sub checkFile
+{
+  my ($plugin, $f, $ctx) = @_;
+
+  my ($issues, @lines) = $plugin->check($f, $ctx);
+  $issues = 0 if (!defined($issues));
+  return ($issues, &resultText($ctx, $issues, @lines));
+}
+
+# return the program output text for the specified number of issues and
+# output lines, as returned by check()
+sub resultText
+{
+  my ($ctx, $issues, @lines) = @_;
+
+  my ($out) = "";
+  if (!$ctx->{'quiet'}) {
+    foreach my ($line) (@lines) {
+      $out .= "$line\n";
+    }
+    $out .= "okay\n" if (!$issues);
+  }
+  return $out;
+}
+
+# return a hash of the "krazy-meta: key=value" lines found in the
+# comment header of the specified checker program
+sub pluginMeta
+{
+  my ($p) = @_;
+  my (%meta);
+
+  open my $fh, '<', $p or return %meta;
+  my ($cnt) = 0;
+  while (<$fh>) {
+    last if (++$cnt > 100);
+    if ($_ =~ m/^\W*krazy-meta:\s*([\w-]+)\s*=\s*(.*?)\s*$/) {
+      $meta{lc($1)} = $2;
+    }
+  }
+  close($fh);
+  return %meta;
+}
+
+#==============================================================================
+# Applicability of a checker program, so krazy2 does not start a checker that
+# would only print "okay" for a file.  The conditions are declared with these
+# "krazy-meta:" comment lines, all of which must hold for the checker to run:
+#   types=<type[,type1,...]>:      the file types checked (for general checkers)
+#   files=<kind[,kind1,...]>:      the kinds of file checked, all of which must
+#                                  apply; a kind starting with '!' must not apply.
+#                                  The kinds are header (a C/C++ include file),
+#                                  c (a C source file), private (a private C++
+#                                  header or source) and tests (a file in a tests
+#                                  or autotests directory).
+#   check-sets=<set[,set1,...]>:   at least one of these check-sets must be in use;
+#                                  a set ending with '*' is a prefix, like kde*
+#   priority=<prio[,prio1,...]>:   the priorities of the issues reported
+#   strict=<level[,level1,...]>:   the strictness levels of the issues reported
+#   triggers=<lit[,lit1,...]>:     literal strings, at least one of which must be
+#                                  in the file for the checker to find an issue.
+#                                  They are case-sensitive and are searched for in
+#                                  the raw file content, so a trigger must not be
+#                                  something the checker only sees after removing
+#                                  comments (like SIG/**/NAL), nor contain a comma.
+#==============================================================================
+
+my (%FileKinds) = (
+  'header'  => \&isCInclude,
+  'c'       => \&isCSource,
+  'private' => \&isPrivateSource,
+  'tests'   => sub {return $_[0] =~ m+/(?:auto)?tests/+;},
+);
+
+# return true if any of the comma-separated values is wanted
+sub anyOf
+{
+  my ($values, $wanted) = @_;
+  foreach my ($v) (split(/\s*,\s*/, lc($values))) {
+    return 1 if (&{$wanted}($v));
+  }
+  return 0;
+}
+
+# return a function telling if the checker program with the specified meta
+# information applies to a file, with the settings of the context hash.
+# returns undef if the checker declares no conditions on the files it checks.
+sub pluginFilter
+{
+  my ($meta, $ctx) = @_;
+
+  # the conditions that hold for every file
+  my ($runs) = 1;
+  if (defined($meta->{'check-sets'})) {
+    my (@sets) = split(",", lc($ctx->{'checksets'}));
+    $runs &&= &anyOf(
+      $meta->{'check-sets'},
+      sub {
+        my ($s) = @_;
+        return ($s =~ s/\*$//) ? grep {index($_, $s) == 0} @sets : grep {$_ eq $s} @sets;
+      }
+    );
+  }
+  if (defined($meta->{'priority'}) && $ctx->{'priority'} ne "all") {
+    my ($p) = $ctx->{'priority'};
+    $runs &&= &anyOf($meta->{'priority'}, sub {$_[0] eq $p || ($p eq "important" && $_[0] =~ m/^(?:normal|high)$/)});
+  }
+  if (defined($meta->{'strict'}) && $ctx->{'strict'} ne "all") {
+    my ($s) = $ctx->{'strict'};
+    $runs &&= &anyOf($meta->{'strict'}, sub {$_[0] eq $s});
+  }
+  return sub {return 0;} if (!$runs);
+
+  # the conditions on the file
+  my (@types) = defined($meta->{'types'}) ? split(/\s*,\s*/, $meta->{'types'}) : ();
+  my (@kinds) = ();
+  foreach my ($k) (defined($meta->{'files'}) ? split(/\s*,\s*/, lc($meta->{'files'})) : ()) {
+    my ($not) = ($k =~ s/^!//);
+    push(@kinds, [$FileKinds{$k}, $not]) if (defined($FileKinds{$k}));
+  }
+  return undef if ($#types < 0 && $#kinds < 0);    ## no critic
+  return sub {
+    my ($f) = @_;
+    if ($#types >= 0) {
+      my ($t) = &fileType($f);
+      return 0 if (!grep {$_ eq $t} @types);
+    }
+    foreach my ($k) (@kinds) {
+      return 0 if (!&{$k->[0]}($f) == !$k->[1]);
+    }
+    return 1;
+  };
+}
+
+# return the trigger literals of the checker program with the specified
+# meta information, or an empty list if the checker declares none
+sub pluginTriggers
+{
+  my ($meta) = @_;
+  return () if (!defined($meta->{'triggers'}));
+  return grep {$_ ne ""} split(/\s*,\s*/, $meta->{'triggers'});
+}
+
+# return a function searching a content (passed by reference) for all the
+# specified trigger literals at once; it returns a hash of those found.
+sub triggerScanner
+{
+  my (@triggers) = @_;
+
+  my (%uniq) = map {$_ => 1} @triggers;
+  @triggers = sort {length($b) <=> length($a) || $a cmp $b} keys %uniq;
+  return sub {return {};} if ($#triggers < 0);
+
+  # a lookahead finds the triggers overlapping each other too; at a position
+  # only the longest trigger is reported, the ones it starts with are added after.
+  my ($alt) = join("|", map {quotemeta($_)} @triggers);
+  my ($re)  = qr/(?=($alt))/;
+  return sub {
+    my ($content) = @_;
+    my (%seen);
+    while ($$content =~ m/$re/g) {
+      $seen{$1} = 1;
+    }
+    my (%found);
+    foreach my ($t) (@triggers) {
+      $found{$t} = 1 if ($seen{$t} || grep {index($_, $t) == 0} keys %seen);
+    }
+    return \%found;
+  };
+}
+
+# load the plugin at the specified path into this interpreter.
+# returns the plugin object, or undef if the plugin could not be loaded.
+sub loadPlugin
+{
+  my ($p) = @_;
+
+  my ($rp) = abs_path($p);
+  return undef if (!defined($rp));    ## no critic
+  return $Plugins{$rp} if (exists($Plugins{$rp}));
+
+  $Hosted = 1;
+  $Loaded = '';
+  {
+    local @ARGV = ();
+    local $0    = $rp;
+
+    # $FindBin::Bin and friends give the directory of the plugin while it loads
+    local ($FindBin::Bin, $FindBin::Script, $FindBin::RealBin, $FindBin::RealScript);
+    FindBin::again();
+    do $rp;
+  }
+  $Hosted = 0;
+
+  my ($plugin);
+  if (!$@ && $Loaded && $Loaded->isa('Krazy::Plugin')) {
+    $plugin = $Loaded->new();
+    $plugin->prepare();
+  } else {
+    print STDERR "Cannot load plugin $p in-process: " . ($@ ? $@ : "no Krazy::Plugin registered\n");
+  }
+  $Plugins{$rp} = $plugin;
+  return $plugin;
+}
+
+# run a loaded plugin on the specified file, returning the same output text
+# the plugin would have printed when run as a program.
+sub runPlugin
+{
+  my ($plugin, $f, $ctx) = @_;
+
+  &setArgs(%{$ctx});
+  my ($issues, $out) = eval {&checkFile($plugin, $f, $ctx);};
+  if ($@) {
+    return ("", 255 << 8);
+  }
+  $out .= "ISSUES=$issues\n" if ($issues > 0);
+  return ($out, 0);
+}
+
+1;
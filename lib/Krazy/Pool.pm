@@ -0,0 +1,239 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Pool;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use IO::Select;
+use POSIX ();
+use Time::HiRes qw(time);
+use Krazy::Profile;
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(numCPUs validateJobs runPool);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# A bounded pool of worker processes.
+#
+# Each work item is a hash reference holding either the command line to run
+# in the 'cmd' key, or a perl code reference in the 'code' key which returns
+# the output text and exit status of the item.  Code items run in a forked
+# worker process, or directly in this process when only 1 job is allowed.
+# Code items with a true 'fork' key always run in a worker process; such code
+# may print its output to stdout and exit the worker itself.
+# An item may have a 'prepare' code reference too, which is called with the
+# item in this process right before the item starts, to compute what the
+# workers of this and later items then inherit, or to complete its command.
+# An item with a 'result' key, holding an (output, exit status) array
+# reference, is already complete and is only retired.
+# An item with a 'wait' key, holding another item given before it, is not
+# started before that item is retired; the retire callback of that item may
+# still give it its 'result'.  The items after it are started meanwhile.
+# Retired items get a true 'retired' key.
+#
+# At most $jobs items run at the same time; the output of each item is
+# collected from a pipe and, once the item has finished, the retire
+# callback is invoked with the item, its output and its exit status.
+#
+# Items are always retired in the order they were given, no matter in which
+# order they complete, so the callers see exactly what a serial run would see.
+#
+# Each item that ran gets 'started' and 'finished' keys holding its start and
+# end times, and a 'slot' key holding the number (1 to $jobs) of the worker
+# it ran in, or 0 if it ran in this process.  When profiling, each item that
+# ran also gets a 'usage' key holding its wall time, CPU times and peak
+# memory use (see Krazy::Profile).
+#==============================================================================
+
+# return the number of online processors, or 1 if that cannot be determined
+sub numCPUs
+{
+  my ($n) = `getconf _NPROCESSORS_ONLN 2>/dev/null`;
+  $n = `sysctl -n hw.ncpu 2>/dev/null` if (!defined($n) || $n !~ m/^\s*\d+\s*$/);
+  if (defined($n) && $n =~ m/^\s*(\d+)\s*$/ && $1 > 0) {
+    return $1;
+  }
+  return 1;
+}
+
+# returns 1 if the specified number of jobs is valid
+sub validateJobs
+{
+  my ($jobs) = @_;
+  return (defined($jobs) && $jobs =~ m/^\d+$/ && $jobs > 0);
+}
+
+# start running the specified work item, connecting its stdout to a pipe.
+# returns the pipe, or undef if the item already finished (or failed to start).
+sub startItem
+{
+  my ($item, $inline, $profile) = @_;
+
+  my ($fh);
+  $item->{'out'}    = "";
+  $item->{'status'} = 0;
+  if (defined($item->{'result'})) {
+    ($item->{'out'}, $item->{'status'}) = @{$item->{'result'}};
+    return;
+  }
+  $item->{'started'} = time();
+  $item->{'slot'}    = 0;
+  $item->{'prepare'}->($item) if (defined($item->{'prepare'}));
+  if (defined($item->{'code'})) {
+
+    # perl code that can run right here, or in a forked worker process
+    if ($inline && !$item->{'fork'}) {
+      my ($before) = $profile ? &selfUsage() : undef;
+      ($item->{'out'}, $item->{'status'}) = $item->{'code'}->();
+      $item->{'finished'} = time();
+      if ($profile) {
+        my ($after) = &selfUsage();
+        $item->{'usage'} = {
+          'wall'   => $item->{'finished'} - $item->{'started'},
+          'user'   => $after->{'user'} - $before->{'user'},
+          'sys'    => $after->{'sys'} - $before->{'sys'},
+          'maxrss' => $after->{'maxrss'},
+        };
+      }
+      return;
+    }
+    $item->{'pid'} = open($fh, "-|");
+    if (defined($item->{'pid'}) && $item->{'pid'} == 0) {
+      open(STDERR, '>', '/dev/null');
+      my ($out, $status) = $item->{'code'}->();
+      print STDOUT $out;
+      close(STDOUT);
+      POSIX::_exit($status >> 8);
+    }
+  } else {
+    $item->{'pid'} = open($fh, "$item->{'cmd'} |");    ## no critic
+  }
+  if (!$item->{'pid'}) {
+    print STDERR "Cannot run: " . ($item->{'cmd'} ? $item->{'cmd'} : "worker process") . "\n";
+    return;
+  }
+  $item->{'fh'} = $fh;
+  return $fh;
+}
+
+# close the pipe of a finished item and reap its process, measuring the
+# resources it used when profiling
+sub reapItem
+{
+  my ($item, $profile) = @_;
+
+  if (!$profile) {
+    close($item->{'fh'});
+    $item->{'status'}   = $?;
+    $item->{'finished'} = time();
+    return;
+  }
+
+  my ($cuser, $csys) = &childTimes();
+  my ($status, $usage) = &waitUsage($item->{'pid'});
+  close($item->{'fh'});    # only reaps the process if wait4 didn't
+  if (defined($usage)) {
+    $item->{'status'} = $status;
+  } else {
+    $item->{'status'} = $?;
+    my ($user, $sys) = &childTimes();
+    $usage = {'user' => $user - $cuser, 'sys' => $sys - $csys, 'maxrss' => 0};
+  }
+  $item->{'finished'} = time();
+  $usage->{'wall'}    = $item->{'finished'} - $item->{'started'};
+  $item->{'usage'}    = $usage;
+}
+
+# run all the work items, using at most $jobs worker processes.
+# $retire is called as $retire->($item, $output, $status) in item order.
+# if $profile is true, the resource usage of the items is measured.
+sub runPool
+{
+  my ($jobs, $items, $retire, $profile) = @_;
+
+  my ($sel)     = IO::Select->new();
+  my ($next)    = 0;                   # index of the next item to start
+  my ($done)    = 0;                   # index of the next item to retire
+  my ($nrun)    = 0;                   # number of items currently running
+  my (%running) = ();                  # fileno => item index
+  my (%finished);                      # item index => 1 when complete
+  my (@slots)   = ();                  # the numbers of the free workers
+  my (@waiting) = ();                  # indexes of the items passed over for their 'wait' item
+
+  $jobs  = 1 if (!&validateJobs($jobs));
+  @slots = (1 .. $jobs);
+
+  while ($done <= $#{$items}) {
+
+    # keep the pool full, with the waiting items whose wait is over first,
+    # passing over the items that must still wait
+    while ($nrun < $jobs) {
+      my ($i) = undef;
+      foreach my ($w) (0 .. $#waiting) {
+        next if (!$items->[$waiting[$w]]{'wait'}{'retired'});
+        $i = splice(@waiting, $w, 1);
+        last;
+      }
+      while (!defined($i) && $next <= $#{$items}) {
+        if ($items->[$next]{'wait'} && !$items->[$next]{'wait'}{'retired'}) {
+          push(@waiting, $next++);
+        } else {
+          $i = $next++;
+        }
+      }
+      last if (!defined($i));
+
+      my ($fh) = &startItem($items->[$i], $jobs == 1, $profile);
+      if ($fh) {
+        $items->[$i]{'slot'} = shift(@slots);
+        $sel->add($fh);
+        $running{fileno($fh)} = $i;
+        $nrun++;
+      } else {
+        $finished{$i} = 1;
+        last if ($nrun == 0);    # retire it before running more items in this process
+      }
+    }
+
+    # collect output from whatever is ready
+    if ($nrun > 0) {
+      foreach my ($fh) ($sel->can_read()) {
+        my ($i)   = $running{fileno($fh)};
+        my ($buf) = "";
+        my ($n)   = sysread($fh, $buf, 65536);
+        if ($n) {
+          $items->[$i]{'out'} .= $buf;
+          next;
+        }
+        $sel->remove($fh);
+        delete $running{fileno($fh)};
+        &reapItem($items->[$i], $profile);
+        push(@slots, $items->[$i]{'slot'});
+        delete $items->[$i]{'fh'};
+        $finished{$i} = 1;
+        $nrun--;
+      }
+    }
+
+    # retire, in order, everything that is complete
+    while ($done <= $#{$items} && $finished{$done}) {
+      my ($item) = $items->[$done];
+      $retire->($item, $item->{'out'}, $item->{'status'});
+      $item->{'retired'} = 1;
+      delete $item->{'out'};
+      delete $finished{$done};
+      $done++;
+    }
+  }
+}
+
+1;
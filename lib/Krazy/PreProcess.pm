@@ -17,24 +17,32 @@ $VERSION = 1.00;
 @EXPORT    = qw(RemoveCommentsC RemoveIfZeroBlockC RemoveCondBlockC RemoveCommentsFDO);
 @EXPORT_OK = qw();
 
+# The lexical elements of C/C++ source that RemoveCommentsC() tells apart,
+# all captured: a C-style comment (captured again by itself), a C++ comment,
+# a raw string, a character literal and a string literal.  The last four are
+# passed over whole, so a "/*" inside them does not start a comment.  A C++
+# comment goes on after a line splice; a literal that is not closed on its
+# line ends there.  A quote following a word (like 1'000) is not a literal.
+# The lookahead lets the regex engine skip quickly to where an element may start.
+my ($CLexeme) = qr{(?=[/"'RuUL])(
+    (/\*.*?\*/)
+  | //(?:[^\\\n]|\\.)*+
+  | (?<!\w)(?:u8|[uUL])?R"([^()\\\s"]{0,16})\(.*?\)\3"
+  | (?<!\w)(?:u8|[uUL])?'(?:[^'\\\n]|\\.)*+'?
+  | "(?:[^"\\\n]|\\.)*+"?
+)}sx;
+
 # Replace C-style comments with whitespace in C/C++ source.
+# The source is scanned once, in linear time.
 sub RemoveCommentsC
 {
 
   my (@data_lines) = @_;
 
-  #get all the c-style comments from the file
-  my ($data)     = "@data_lines";
-  my (@comments) = ($data =~ /\/\*.*?\*\//gs);
-
-  #for each comment, remove everything but the linebreaks, so
+  #remove everything but the linebreaks from the c-style comments, so
   #our line numbering report does not get screwed up.
-  foreach my $comment (@comments) {
-    my ($fixed_comment) = $comment;
-    $fixed_comment =~ s/[^\n]//gs;
-    $fixed_comment =~ s/\n/\n/gs;
-    $data          =~ s/\Q$comment/$fixed_comment/s;
-  }
+  my ($data) = "@data_lines";
+  $data =~ s/$CLexeme/defined($2) ? "\n" x ($2 =~ tr{\n}{}) : $1/ge;
 
   #return array
   return split(/\n/, $data);
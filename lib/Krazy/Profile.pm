@@ -0,0 +1,196 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Profile;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use JSON;
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(waitUsage selfUsage childTimes profileRecord profileDriver profileReport profileJSON);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# Resource usage profiling of the checker program runs.
+#
+# For every run of a checker program, profileRecord() is given the wall
+# time, the user and system CPU time and the peak resident set size used.
+# Child processes are reaped with the wait4 system call, which returns their
+# resource usage; where that system call is not available, the CPU times
+# come from the difference in the times() children totals across the reaping
+# of the child, and the peak memory use is unknown.
+#
+# profileDriver() adds up the time spent by the driver itself in the named
+# activity, like resolving paths or reading files.
+#
+# At the end of the run, profileReport() prints the totals per checker and
+# per file type and the slowest runs, and profileJSON() writes all the data
+# to a JSON file.
+#==============================================================================
+
+my (@Records);    # the checker runs, as hashes
+my (%Driver);     # driver activity => seconds
+
+# return the number of the specified system call, or 0 if unknown
+sub syscallNumber
+{
+  my ($name) = @_;
+
+  # syscall.ph defines its functions in the package requiring it first
+  my ($nr) = eval {
+
+    package main;
+    require 'syscall.ph';    ## no critic
+    no strict 'refs';
+    &{"main::SYS_$name"}();
+  };
+  return $nr ? $nr : 0;
+}
+
+# unpack a struct rusage into a usage hash: CPU times in seconds, max RSS in KB
+sub unpackUsage
+{
+  my ($buf) = @_;
+  my (@ru) = unpack("l!18", $buf);
+  return {
+    'user'   => $ru[0] + $ru[1] / 1e6,
+    'sys'    => $ru[2] + $ru[3] / 1e6,
+    'maxrss' => $ru[4],
+  };
+}
+
+# reap the specified child process, returning its exit status and usage hash.
+# returns an empty list if the resource usage of children can't be had this way.
+sub waitUsage
+{
+  my ($pid) = @_;
+
+  my ($nr) = &syscallNumber("wait4");
+  return () if (!$nr);
+  my ($status) = pack("i", 0);
+  my ($ru)     = "\0" x 256;
+  my ($r)      = syscall($nr, $pid + 0, $status, 0, $ru);
+  return () if ($r != $pid);
+  return (unpack("i", $status), &unpackUsage($ru));
+}
+
+# return the usage hash of this process
+sub selfUsage
+{
+  my ($nr) = &syscallNumber("getrusage");
+  my ($ru) = "\0" x 256;
+  if ($nr && syscall($nr, 0, $ru) == 0) {
+    return &unpackUsage($ru);
+  }
+  my ($user, $sys) = times();
+  return {'user' => $user, 'sys' => $sys, 'maxrss' => 0};
+}
+
+# return the (user, system) CPU times of the reaped child processes
+sub childTimes
+{
+  my (@t) = times();
+  return ($t[2], $t[3]);
+}
+
+# record a checker run: the checker, the file type, the file (or a description
+# of the files) checked and the usage hash, which holds the wall time as well
+sub profileRecord
+{
+  my ($checker, $type, $file, $usage) = @_;
+  push(
+    @Records,
+    {
+      'checker' => $checker,
+      'type'    => $type,
+      'file'    => $file,
+      'wall'    => $usage->{'wall'},
+      'user'    => $usage->{'user'},
+      'sys'     => $usage->{'sys'},
+      'maxrss'  => $usage->{'maxrss'},
+    }
+  );
+}
+
+# add the specified number of seconds to the time spent in a driver activity
+sub profileDriver
+{
+  my ($what, $secs) = @_;
+  $Driver{$what} += $secs;
+}
+
+# return the totals of the records, grouped by the specified record key
+sub totals
+{
+  my ($key) = @_;
+  my (%t);
+  foreach my ($r) (@Records) {
+    my ($t) = $t{$r->{$key}} ||= {$key => $r->{$key}, 'runs' => 0, 'wall' => 0, 'user' => 0, 'sys' => 0, 'maxrss' => 0};
+    $t->{'runs'}++;
+    $t->{$_} += $r->{$_} foreach ('wall', 'user', 'sys');
+    $t->{'maxrss'} = $r->{'maxrss'} if ($r->{'maxrss'} > $t->{'maxrss'});
+  }
+  return sort {$b->{'wall'} <=> $a->{'wall'}} values %t;
+}
+
+# print a line of the report table
+sub printRow
+{
+  my ($t, $name) = @_;
+  printf STDERR ("  %9.3f %9.3f %9.3f %9.1f %6s  %s\n",
+    $t->{'wall'}, $t->{'user'}, $t->{'sys'}, $t->{'maxrss'} / 1024, defined($t->{'runs'}) ? $t->{'runs'} : "", $name);
+}
+
+# print the profile report to stderr, with the specified number of slowest runs.
+# $wall is the wall time of the whole run, in seconds.
+sub profileReport
+{
+  my ($top, $wall) = @_;
+
+  my ($heading) = sprintf("  %9s %9s %9s %9s %6s  %s\n", "wall(s)", "user(s)", "sys(s)", "RSS(MB)", "runs", "");
+  printf STDERR ("Profile: %d checker runs in %.3fs\n", scalar(@Records), $wall);
+
+  print STDERR "Per checker:\n" . $heading;
+  &printRow($_, $_->{'checker'}) foreach (&totals('checker'));
+
+  print STDERR "Per file type:\n" . $heading;
+  &printRow($_, $_->{'type'}) foreach (&totals('type'));
+
+  my (@slowest) = sort {$b->{'wall'} <=> $a->{'wall'}} @Records;
+  $#slowest = $top - 1 if ($#slowest >= $top);
+  print STDERR "Slowest $top checker runs:\n" . $heading;
+  &printRow($_, "$_->{'checker'} $_->{'file'}") foreach (@slowest);
+
+  print STDERR "Driver overhead:\n";
+  foreach my ($what) (sort {$Driver{$b} <=> $Driver{$a}} keys %Driver) {
+    printf STDERR ("  %9.3f  %s\n", $Driver{$what}, $what);
+  }
+}
+
+# write the profile data, with the specified hash of run information, to a JSON file.
+# returns 1 on success, 0 otherwise.
+sub profileJSON
+{
+  my ($path, $info) = @_;
+
+  my ($data) = {
+    %{$info},
+    'checkers' => [&totals('checker')],
+    'types'    => [&totals('type')],
+    'driver'   => \%Driver,
+    'runs'     => \@Records,
+  };
+  open(my $fh, '>', $path) or return 0;
+  print $fh JSON->new->pretty->canonical->encode($data);
+  return close($fh);
+}
+
+1;
@@ -13,6 +13,7 @@ use Cwd;
 use Cwd 'abs_path';
 use File::Basename;
 use File::Spec::Functions 'catfile';
+use Krazy::PatternSet;
 
 use Exporter;
 $VERSION = 0.96;
@@ -46,14 +47,13 @@ sub linesCaseSearchInFile
 
   open my $fh, '<:encoding(UTF-8)', $f or return $cnt;
   $cnt++;
+  my ($set) = Krazy::PatternSet->new([@lines], 'icase' => 1);
   while (<$fh>) {
     $cnt++;
     chomp($_);
-    for my ($l) (@lines) {
-      if ($_ =~ m/$l/i) {
-        close($fh);
-        return $cnt;
-      }
+    if ($set->test($_)) {
+      close($fh);
+      return $cnt;
     }
   }
   close($fh);
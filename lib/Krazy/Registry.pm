@@ -0,0 +1,166 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Registry;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use File::Find;
+use Time::HiRes;
+use Krazy::Store;
+use Krazy::Plugin;
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(registryPath registryOpen registryScan registryInfo registryMeta registrySave);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# A cache of what krazy2 learns about the checker programs at startup, so
+# repeated runs don't search the plugin, extra and set directories nor run
+# every checker with --help, --explain or --version again.
+#
+# The directory scans are remembered along with the modification times of
+# all the directories searched; a scan is redone when any of them changed.
+# The information about a checker program (its help, explanation, version
+# and krazy-meta lines) is remembered along with the modification time and
+# size of the program, and asked again when either changed.
+#
+# The registry is a store (see Krazy::Store), written back at exit if
+# anything changed.
+#==============================================================================
+
+my ($FORMAT)   = 1;     # the version of the registry layout
+my ($Path)     = '';    # the registry file, if in use
+my ($Dirty)    = 0;     # true if the registry needs saving
+my (%Registry) = ('format' => $FORMAT, 'scans' => {}, 'checkers' => {});
+
+# return the default registry file path, under the XDG cache directory
+sub registryPath
+{
+  return &storePath('registry');
+}
+
+# start using the registry in the specified file, which may not exist yet
+sub registryOpen
+{
+  my ($path) = @_;
+
+  $Path = $path;
+  my ($r) = &storeOpen($path, $FORMAT);
+  %Registry = %{$r} if ($r);
+}
+
+# return the modification time of the specified path, or undef if it is gone
+sub mtime
+{
+  my ($path) = @_;
+  my (@st) = Time::HiRes::stat($path);
+  return $#st < 0 ? undef : $st[9];
+}
+
+# return the executable files found in the specified directory trees,
+# in the order File::Find visits them
+sub registryScan
+{
+  my (@roots) = @_;
+
+  my (@files) = ();
+  foreach my ($root) (@roots) {
+    my ($scan) = $Path ? $Registry{'scans'}{$root} : undef;
+    if ($scan) {
+      foreach my ($dir) (keys %{$scan->{'dirs'}}) {
+        my ($t) = &mtime($dir);
+        if (!defined($t) || $t != $scan->{'dirs'}{$dir}) {
+          $scan = undef;
+          last;
+        }
+      }
+    }
+    if (!$scan) {
+      $scan = {'dirs' => {}, 'files' => []};
+      find(
+        sub {
+          if (-d $_) {
+            $scan->{'dirs'}{$File::Find::name} = &mtime($_);
+          } elsif (-x _) {
+            push(@{$scan->{'files'}}, $File::Find::name);
+          }
+        },
+        $root
+      );
+      if ($Path) {
+        $Registry{'scans'}{$root} = $scan;
+        $Dirty = 1;
+      }
+    }
+    push(@files, @{$scan->{'files'}});
+  }
+  return @files;
+}
+
+# return the registry entry of the specified checker program, emptied if
+# the program changed since the entry was made
+sub checkerEntry
+{
+  my ($p) = @_;
+
+  my (@st) = Time::HiRes::stat($p);
+  my ($stamp) = $#st < 0 ? "" : "$st[9]:$st[7]";
+  my ($entry) = $Registry{'checkers'}{$p};
+  if (!$entry || $entry->{'stamp'} ne $stamp) {
+    $entry = $Registry{'checkers'}{$p} = {'stamp' => $stamp};
+    $Dirty = 1;
+  }
+  return $entry;
+}
+
+# return the output of the specified checker program run with the --help,
+# --explain or --version option (the $what) and the additional options
+sub registryInfo
+{
+  my ($p, $what, $opts) = @_;
+  $opts = "" if (!defined($opts));
+
+  my ($entry) = $Path ? &checkerEntry($p) : {};
+  my ($key) = "$what $opts";
+  if (!defined($entry->{$key})) {
+    $entry->{$key} = join("", `$p --$what $opts 2>/dev/null`);
+    $Dirty = 1;
+  }
+  return $entry->{$key};
+}
+
+# return the hash of the "krazy-meta:" lines of the specified checker program
+sub registryMeta
+{
+  my ($p) = @_;
+
+  return &pluginMeta($p) if (!$Path);
+  my ($entry) = &checkerEntry($p);
+  if (!defined($entry->{'meta'})) {
+    $entry->{'meta'} = {&pluginMeta($p)};
+    $Dirty = 1;
+  }
+  return %{$entry->{'meta'}};
+}
+
+# write the registry back to its file, if anything changed.
+# returns 1 on success (or when there was nothing to write), 0 otherwise.
+sub registrySave
+{
+  return 1 if (!$Path || !$Dirty);
+  return 0 if (!&storeSave($Path, \%Registry));
+  $Dirty = 0;
+  return 1;
+}
+
+&storeAtExit(\&registrySave);
+
+1;
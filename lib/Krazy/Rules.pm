@@ -0,0 +1,400 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Rules;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use Cwd 'abs_path';
+use Krazy::Plugin;
+use Krazy::PreProcess;
+use Krazy::Source;
+use Krazy::Utils;
+use parent 'Krazy::Plugin';
+
+$VERSION = 1.00;
+
+@EXPORT    = qw();
+@EXPORT_OK = qw();
+
+#==============================================================================
+# Checker programs made of line rules instead of code.
+#
+# Many checkers only look at each line of a file for a few regular
+# expressions, with the same handling of the krazy:exclude, krazy:excludeall
+# and krazy:skip comments.  Such a checker is a rule file: the fixed program
+# text of plugins/TEMPLATE.rules, with the "# krazy-meta:" lines telling the
+# files it applies to (see pluginFilter() in Krazy::Plugin) and its rules
+# after the __DATA__ line.  It runs as a program like any other checker, but
+# krazy2 evaluates the rules of all the rule checkers of a file together, in
+# a single pass over the file (see checkAll()).
+#
+# The rules are "key: value" lines; blank lines and lines starting with '#'
+# are ignored.  The keys before the first rule describe the checker:
+#   name:    the name of the checker
+#   version: its version
+#   help:    its one-line help message
+#   explain: its explanation, with solving instructions
+#   source:  the lines looked at: "code" (the default) for the C/C++ code
+#            without comments, #if 0 blocks and Krazy conditional blocks,
+#            or "text" for the lines of the file without the Krazy
+#            conditional blocks only
+#   head:    look at this many lines at the top of the file only
+#   count:   "lines" (the default) to count a line once, for the first rule
+#            matching it, or "matches" to count every rule matching the line
+#   strip:   a regular expression, whose matches are replaced by a space in
+#            the lines before the rules are matched; C++ comments are always
+#            removed from "code" lines
+#   report:  the default report line of the rules (see below)
+#
+# Each "rule:" key starts a rule, which matches a line when its regular
+# expression, or that of any "or:" key following it, matches.  The keys
+# following a rule refine it:
+#   or:          another regular expression matching for the rule
+#   unless:      the rule does not match a line this expression matches
+#   strip:       as above, for the rule only
+#   near:        "N regex": the rule matches only if the expression matches
+#                one of the N lines ending with the line, comments included
+#   unless-near: "N regex": the rule does not match if the expression matches
+#                one of those lines; $1 to $9 stand for what the groups of
+#                the rule expression matched
+#   final:       "yes" if no rule after this one is tried on a line the
+#                rule expression matches, even when the line is excluded by
+#                an "unless" key
+#   lines:       "N" or "N-M": the rule applies to those line numbers only
+#   types:       the file types the rule applies to
+#   note:        a text added after the line number of each match
+#   report:      the report line of the rule, where %l stands for the list
+#                of the line numbers and %n for their number; the rules
+#                with the same report line share it.  The default is
+#                "line#%l (%n)".
+#   each:        makes a copy of the rule for the whitespace separated
+#                fields of the value, with %1 to %9 in the values of the
+#                other keys of the rule standing for the fields
+#==============================================================================
+
+my (%RuleFile) = ();    # rule checker class => its rule file
+my (%Rules)    = ();    # rule checker class => its compiled rules
+
+# the keys describing the checker, and those refining a rule
+my (%CheckerKeys) = map {$_ => 1} qw(name version help explain source head count strip report);
+my (%RuleKeys)    = map {$_ => 1} qw(rule or unless strip near unless-near final lines types note report each);
+
+# run the rule checker as a program, or register it if being loaded by krazy2;
+# the rules are read first, so an error in them fails the loading
+sub run
+{
+  my ($class) = @_;
+
+  $RuleFile{$class} = abs_path($0) || $0;
+  $Rules{$class}    = &parseRules($RuleFile{$class});
+  return $class->SUPER::run();
+}
+
+# return the compiled rules of the rule checker (a class or an object)
+sub rules
+{
+  my ($self) = @_;
+  my ($class) = ref($self) || $self;
+  $Rules{$class} = &parseRules($RuleFile{$class}) if (!$Rules{$class});
+  return $Rules{$class};
+}
+
+sub name    {return $_[0]->rules()->{'name'};}
+sub version {return $_[0]->rules()->{'version'};}
+sub help    {return $_[0]->rules()->{'help'};}
+sub explain {return $_[0]->rules()->{'explain'};}
+
+sub check
+{
+  my ($self, $f, $ctx) = @_;
+  return @{(&checkAll([$self], $f, $ctx))[0]};
+}
+
+# return the compiled regular expression, dying with the position in the
+# rule file if it is not valid
+sub compile
+{
+  my ($re, $where) = @_;
+  my ($qr) = eval {qr/$re/};
+  die "$where: bad regular expression \"$re\": $@" if (!defined($qr));
+  return $qr;
+}
+
+# return the value with %1 to %9 replaced by the specified fields
+sub fill
+{
+  my ($v, @fields) = @_;
+  $v =~ s/%([1-9])/defined($fields[$1 - 1]) ? $fields[$1 - 1] : ''/ge;
+  return $v;
+}
+
+# return the compiled rules read after the __DATA__ line of the specified file
+sub parseRules
+{
+  my ($path) = @_;
+
+  open(my $fh, '<', $path) or die "Cannot read the rules of $path: $!\n";
+  my (@lines) = <$fh>;
+  close($fh);
+  my ($n) = 0;
+  $n++ while ($n <= $#lines && $lines[$n] !~ m/^__DATA__\s*$/);
+
+  my ($checker) = {
+    'name'    => '',
+    'version' => '',
+    'help'    => '',
+    'explain' => '',
+    'source'  => 'code',
+    'head'    => 0,
+    'count'   => 'lines',
+    'strip'   => [],
+    'report'  => 'line#%l (%n)',
+  };
+  my (@raw) = ();    # the rules, as lists of [key, value, where]
+  while (++$n <= $#lines) {
+    my ($line) = $lines[$n];
+    next if ($line =~ m/^\s*(#.*)?$/);
+    my ($where) = "$path:" . ($n + 1);
+    die "$where: not a \"key: value\" line\n" if ($line !~ m/^\s*([\w-]+)\s*:\s*(.*?)\s*$/);
+    my ($key, $value) = (lc($1), $2);
+
+    if ($key eq 'rule') {
+      push(@raw, [[$key, $value, $where]]);
+    } elsif ($#raw >= 0 && $RuleKeys{$key}) {
+      push(@{$raw[-1]}, [$key, $value, $where]);
+    } elsif ($#raw < 0 && $CheckerKeys{$key}) {
+      if ($key eq 'strip') {
+        push(@{$checker->{'strip'}}, &compile($value, $where));
+      } else {
+        $checker->{$key} = $value;
+      }
+    } else {
+      die "$where: unexpected key \"$key\"\n";
+    }
+  }
+  die "$path: the rules have no name\n" if ($checker->{'name'} eq '');
+  die "$path: unknown source \"$checker->{'source'}\"\n" if ($checker->{'source'} !~ m/^(code|text)$/);
+  die "$path: unknown count \"$checker->{'count'}\"\n"   if ($checker->{'count'} !~ m/^(lines|matches)$/);
+
+  # make the rules, a copy for each "each" key
+  my (@rules) = ();
+  foreach my ($keys) (@raw) {
+    my (@each) = map {[split(' ', $_->[1])]} grep {$_->[0] eq 'each'} @{$keys};
+    @each = ([]) if ($#each < 0);
+    foreach my ($fields) (@each) {
+      my ($rule) = {
+        'patterns' => [],
+        'unless'   => [],
+        'strip'    => [],
+        'near'     => [],
+        'unear'    => [],
+        'final'    => 0,
+        'note'     => '',
+        'report'   => $checker->{'report'},
+      };
+      foreach my ($kv) (@{$keys}) {
+        my ($key, $where) = ($kv->[0], $kv->[2]);
+        my ($value) = &fill($kv->[1], @{$fields});
+        if ($key eq 'rule' || $key eq 'or') {
+          push(@{$rule->{'patterns'}}, &compile($value, $where));
+        } elsif ($key eq 'unless' || $key eq 'strip') {
+          push(@{$rule->{$key}}, &compile($value, $where));
+        } elsif ($key eq 'near' || $key eq 'unless-near') {
+          die "$where: expected \"N regex\"\n" if ($value !~ m/^(\d+)\s+(.+)$/);
+          my ($count, $re) = ($1, $2);
+          if ($key eq 'near') {
+            push(@{$rule->{'near'}}, [$count, &compile($re, $where)]);
+          } else {
+            &compile($re =~ s/\$[1-9]/x/gr, $where);    # check it, it is compiled for each match
+            push(@{$rule->{'unear'}}, [$count, $re]);
+          }
+        } elsif ($key eq 'final') {
+          $rule->{'final'} = ($value =~ m/^(yes|true|1)$/i) ? 1 : 0;
+        } elsif ($key eq 'lines') {
+          die "$where: expected \"N\" or \"N-M\"\n" if ($value !~ m/^(\d+)(?:\s*-\s*(\d+))?$/);
+          $rule->{'lines'} = [$1, defined($2) ? $2 : $1];
+        } elsif ($key eq 'types') {
+          $rule->{'types'} = {map {$_ => 1} split(/\s*,\s*/, $value)};
+        } elsif ($key eq 'note' || $key eq 'report') {
+          $rule->{$key} = $value;
+        }
+      }
+      push(@rules, $rule);
+    }
+  }
+  $checker->{'rules'} = \@rules;
+
+  # the report lines, in the order of the rules
+  my (%seen) = ();
+  $checker->{'reports'} = [grep {!$seen{$_}++} map {$_->{'report'}} @rules];
+
+  # a quick test that a line may match a rule at all, unless a rule matches
+  # the lines after stripping them some more
+  if (!grep {@{$_->{'strip'}}} @rules) {
+    my ($any) = join("|", map {@{$_->{'patterns'}}} @rules);
+    $checker->{'filter'} = qr/$any/ if ($any ne '');
+  }
+
+  my (%meta) = &pluginMeta($path);
+  $checker->{'meta'} = \%meta;
+
+  my ($name) = quotemeta($checker->{'name'});
+  $checker->{'excludeall'} = qr+//.*[Kk]razy:excludeall=.*$name+;
+  $checker->{'exclude'}    = qr+//.*[Kk]razy:exclude=.*$name+;
+  return $checker;
+}
+
+# check the specified file with the specified rule checkers at once, going
+# over the lines of the file once.  A checker whose "krazy-meta:" lines say
+# it does not apply to the file, with the settings of the context hash,
+# finds no issues.  Returns, for each checker, a reference to the list of
+# the number of issues found followed by the output lines (see check() in
+# Krazy::Plugin).
+sub checkAll
+{
+  my ($plugins, $f, $ctx) = @_;
+
+  my ($source)  = Krazy::Source->forFile($f);
+  my ($type)    = &fileType($f);
+  my ($hasCond) = index(${$source->contentRef()}, 'razy:cond') >= 0;
+  my (%views)   = ();    # source => the lines shared by the checkers without conditional blocks
+  my (@states)  = ();
+  my ($max)     = 0;
+  foreach my ($plugin) (@{$plugins}) {
+    my ($r) = $plugin->rules();
+    my ($applies) = &pluginFilter($r->{'meta'}, $ctx);
+    if ($applies && !&{$applies}($f)) {
+      push(@states, {'r' => $r, 'groups' => {}, 'verbose' => [], 'done' => 1});
+      next;
+    }
+    my ($view);
+    if ($hasCond) {
+      my (@lines) =
+        ($r->{'source'} eq 'code')
+        ? $source->noCondLines($r->{'name'})
+        : RemoveCondBlockC($r->{'name'}, $source->lines());
+      $view = {'lines' => \@lines, 'clean' => []};
+    } else {
+      $views{$r->{'source'}} =
+        {'lines' => [($r->{'source'} eq 'code') ? $source->noIfZeroLines() : $source->lines()], 'clean' => []}
+        if (!$views{$r->{'source'}});
+      $view = $views{$r->{'source'}};
+    }
+    my ($state) = {
+      'r'       => $r,
+      'view'    => $view,
+      'rules'   => [grep {!$_->{'types'} || $_->{'types'}{$type}} @{$r->{'rules'}}],
+      'groups'  => {map {$_ => {'n' => 0, 'items' => []}} @{$r->{'reports'}}},
+      'verbose' => [],
+      'done'    => 0,
+    };
+    push(@states, $state);
+    $max = scalar(@{$view->{'lines'}}) if (scalar(@{$view->{'lines'}}) > $max);
+  }
+
+  for (my $i = 0 ; $i < $max ; $i++) {
+    foreach my ($s) (@states) {
+      next if ($s->{'done'});
+      my ($r)    = $s->{'r'};
+      my ($view) = $s->{'view'};
+      my ($line) = $view->{'lines'}[$i];
+      if (!defined($line)) {
+        $s->{'done'} = 1;
+        next;
+      }
+
+      if (index($line, 'razy:') >= 0) {
+        if ($line =~ $r->{'excludeall'} || $line =~ m+//.*[Kk]razy:skip+) {
+          foreach my ($group) (values %{$s->{'groups'}}) {
+            $group->{'n'}     = 0;
+            $group->{'items'} = [];
+          }
+          $s->{'verbose'} = [];
+          $s->{'done'}    = 1;
+          next;
+        }
+        next if ($line =~ $r->{'exclude'});
+      }
+      if ($r->{'head'} && $i >= $r->{'head'}) {
+        $s->{'done'} = 1;
+        next;
+      }
+
+      if ($r->{'source'} eq 'code') {
+        if (!defined($view->{'clean'}[$i])) {
+          $view->{'clean'}[$i] = $line;
+          $view->{'clean'}[$i] =~ s+//.*++;    #skip C++ comments
+        }
+        $line = $view->{'clean'}[$i];
+      }
+      if (@{$r->{'strip'}}) {
+        $line = "$line";
+        $line =~ s/$_/ /g foreach (@{$r->{'strip'}});
+      }
+      next if ($r->{'filter'} && $line !~ $r->{'filter'});
+
+      foreach my ($rule) (@{$s->{'rules'}}) {
+        next if ($rule->{'lines'} && ($i + 1 < $rule->{'lines'}[0] || $i + 1 > $rule->{'lines'}[1]));
+        my ($l) = $line;
+        $l =~ s/$_/ /g foreach (@{$rule->{'strip'}});
+
+        my (@caps) = ();
+        foreach my ($p) (@{$rule->{'patterns'}}) {
+          last if (@caps = ($l =~ $p));
+        }
+        next if (!@caps);
+        if (
+             grep {$l =~ $_} @{$rule->{'unless'}}
+          or grep {!&near($view->{'lines'}, $i, $_->[0], $_->[1])} @{$rule->{'near'}}
+          or grep {
+            my ($re) = $_->[1] =~ s/\$([1-9])/defined($caps[$1 - 1]) ? quotemeta($caps[$1 - 1]) : ''/ger;
+            &near($view->{'lines'}, $i, $_->[0], qr/$re/)
+          } @{$rule->{'unear'}}
+          )
+        {
+          last if ($rule->{'final'});
+          next;
+        }
+
+        my ($group) = $s->{'groups'}{$rule->{'report'}};
+        $group->{'n'}++;
+        push(@{$group->{'items'}}, ($i + 1) . ($rule->{'note'} ne '' ? " $rule->{'note'}" : ''));
+        push(@{$s->{'verbose'}}, "=> " . ($line =~ s/\n$//r)) if ($ctx->{'verbose'});
+        last if ($r->{'count'} eq 'lines');
+      }
+    }
+  }
+
+  my (@results) = ();
+  foreach my ($s) (@states) {
+    my ($issues) = 0;
+    my (@out)    = @{$s->{'verbose'}};
+    foreach my ($report) (@{$s->{'r'}{'reports'}}) {
+      my ($group) = $s->{'groups'}{$report};
+      next if (!$group || !$group->{'n'});
+      $issues += $group->{'n'};
+      my ($list) = join(",", @{$group->{'items'}});
+      push(@out, $report =~ s/%([ln])/$1 eq 'l' ? $list : $group->{'n'}/ger);
+    }
+    push(@results, [$issues, @out]);
+  }
+  return @results;
+}
+
+# return true if the regular expression matches one of the specified number
+# of lines ending with the line of the specified index
+sub near
+{
+  my ($lines, $i, $count, $re) = @_;
+  for (my $j = $i ; $j >= 0 && $j > $i - $count ; $j--) {
+    return 1 if ($lines->[$j] =~ $re);
+  }
+  return 0;
+}
+
+1;
@@ -0,0 +1,220 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Source;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use Cwd 'abs_path';
+use File::Basename;
+use Krazy::Header;
+use Krazy::Lexer;
+use Krazy::PreProcess;
+use Krazy::Utils;
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw();
+@EXPORT_OK = qw();
+
+#==============================================================================
+# The content of a file to check, in the forms the checkers work on.
+#
+# Each form is computed from the previous one the first time it is asked
+# for, and kept, so it is never computed twice for the same file:
+#   content():        the bytes of the file (see fileContent() in Krazy::Utils);
+#                     contentRef() returns a reference to them
+#   lines():          the lines, decoded from UTF-8 (see fileLines())
+#   noCommentLines(): the lines without C-style comments
+#   noIfZeroLines():  the above without #if 0 blocks
+#   noCondLines($checker): the above without the Krazy conditional blocks
+#                     of the checker (//krazy:cond=checker ... //krazy:endcond=checker)
+#   noCppLines():     the noIfZeroLines() with the preprocessor lines emptied
+#   tokens():         the C/C++ tokens of the noIfZeroLines() (see lexC() in
+#                     Krazy::Lexer); a token on line N is on noIfZeroLines()[N-1]
+#   scopes():         the classes and namespaces defined by the tokens (see
+#                     scopesC() in Krazy::Lexer)
+#   includes():       the #include directives of the noIfZeroLines(), with the
+#                     project files they resolve to (see graphIncludes() in
+#                     Krazy::Utils); from the include graph when krazy2 built
+#                     one, else parsed here and resolved next to the file only
+#   header():         the analysis of the license and copyright header of the
+#                     lines (see Krazy::Header)
+# The line lists are returned as copies, which the caller may change; the
+# tokens, scopes, includes and header are returned as references, which the
+# caller must not.
+#
+# Krazy::Source->forFile($f) returns the object of the file, shared by all the
+# checkers of the file run in the same process.  krazy2 makes the objects of
+# the files it checks itself and keeps them with hold(), computing the forms
+# the checkers need before it forks them, so the forked checkers inherit them,
+# until it is done with the file and gives them up with release().
+#==============================================================================
+
+my (%Sources) = ();    # file => the object of the file
+my (@Recent)  = ();    # the files of %Sources not held, the most recently asked for last
+my ($KEEP)    = 4;     # the number of files not held kept in %Sources
+
+# return a new object for the specified file, optionally with a reference
+# to its content (bytes) if it was read already
+sub new
+{
+  my ($class, $f, $ref) = @_;
+  return bless({'file' => $f, 'ref' => $ref}, $class);
+}
+
+# keep the specified object as the one of its file, for as long as this
+# process runs
+sub hold
+{
+  my ($self) = @_;
+  my ($f) = $self->{'file'};
+  @Recent = grep {$_ ne $f} @Recent;
+  $Sources{$f} = $self;
+}
+
+# stop keeping the specified held object, once its file is no longer checked
+sub release
+{
+  my ($self) = @_;
+  my ($f) = $self->{'file'};
+  delete($Sources{$f}) if ($Sources{$f} && $Sources{$f} == $self);
+}
+
+# return the object of the specified file, made the first time it is asked for
+sub forFile
+{
+  my ($class, $f) = @_;
+
+  if (!$Sources{$f}) {
+    $Sources{$f} = $class->new($f);
+    push(@Recent, $f);
+    delete($Sources{shift(@Recent)}) if ($#Recent >= $KEEP);
+  }
+  return $Sources{$f};
+}
+
+sub file
+{
+  my ($self) = @_;
+  return $self->{'file'};
+}
+
+# return a reference to the content, so it need not be copied
+sub contentRef
+{
+  my ($self) = @_;
+  if (!$self->{'ref'}) {
+    my ($content) = &fileContent($self->{'file'});
+    $self->{'ref'} = \$content;
+  }
+  return $self->{'ref'};
+}
+
+sub content
+{
+  my ($self) = @_;
+  return ${$self->contentRef()};
+}
+
+# return true if the content is plain ASCII, so decoding it changes nothing
+sub isAscii
+{
+  my ($self) = @_;
+  $self->{'ascii'} = (${$self->contentRef()} !~ m/[^\x00-\x7f]/) ? 1 : 0 if (!defined($self->{'ascii'}));
+  return $self->{'ascii'};
+}
+
+sub lines
+{
+  my ($self) = @_;
+  if (!$self->{'lines'}) {
+    if ($self->isAscii()) {
+
+      # no need to go through the PerlIO decoding layer
+      $self->{'lines'} = [split(/(?<=\n)/, ${$self->contentRef()})];
+    } else {
+      open my $fh, '<:encoding(UTF-8)', $self->contentRef() or die "Can't decode \"$self->{'file'}\": $!\n";
+      $self->{'lines'} = [<$fh>];
+      close($fh);
+    }
+  }
+  return @{$self->{'lines'}};
+}
+
+sub noCommentLines
+{
+  my ($self) = @_;
+  $self->{'nocomment'} = [RemoveCommentsC($self->lines())] if (!$self->{'nocomment'});
+  return @{$self->{'nocomment'}};
+}
+
+sub noIfZeroLines
+{
+  my ($self) = @_;
+  $self->{'noifzero'} = [RemoveIfZeroBlockC($self->noCommentLines())] if (!$self->{'noifzero'});
+  return @{$self->{'noifzero'}};
+}
+
+sub noCondLines
+{
+  my ($self, $checker) = @_;
+  $self->{'nocond'}{$checker} = [RemoveCondBlockC($checker, $self->noIfZeroLines())]
+    if (!$self->{'nocond'}{$checker});
+  return @{$self->{'nocond'}{$checker}};
+}
+
+sub noCppLines
+{
+  my ($self) = @_;
+  $self->{'nocpp'} = [map {m/^[[:space:]]*#/ ? "\n" : $_} $self->noIfZeroLines()] if (!$self->{'nocpp'});
+  return @{$self->{'nocpp'}};
+}
+
+sub tokens
+{
+  my ($self) = @_;
+  $self->{'tokens'} = &lexC(join("\n", map {my ($l) = $_; chomp($l); $l} $self->noIfZeroLines())) if (!$self->{'tokens'});
+  return $self->{'tokens'};
+}
+
+sub scopes
+{
+  my ($self) = @_;
+  $self->{'scopes'} = &scopesC($self->tokens()) if (!$self->{'scopes'});
+  return $self->{'scopes'};
+}
+
+sub includes
+{
+  my ($self) = @_;
+  if (!$self->{'includes'}) {
+    my ($absf) = abs_path($self->{'file'});
+    $self->{'includes'} = &graphIncludes($absf);
+    if (!$self->{'includes'}) {
+      my ($dir) = defined($absf) ? dirname($absf) : '';
+      $self->{'includes'} = [
+        map {
+          my ($next) = "$dir/$_->{'path'}";
+          +{%{$_}, 'target' => ($dir && $_->{'sep'} ne '' && -f $next) ? abs_path($next) : ''}
+        } &parseIncludes($self->noIfZeroLines())
+      ];
+    }
+  }
+  return $self->{'includes'};
+}
+
+sub header
+{
+  my ($self) = @_;
+  $self->{'header'} = Krazy::Header->new($self->{'file'}, [$self->lines()]) if (!$self->{'header'});
+  return $self->{'header'};
+}
+
+1;
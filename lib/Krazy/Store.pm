@@ -0,0 +1,98 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Store;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use File::Path qw(make_path);
+use File::Temp qw(tempfile);
+use Storable qw(nstore_fd retrieve);
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(storePath storeOpen storeSave storeAtExit);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# Stores of what krazy2 and the checkers learn from one run to the next.
+#
+# A store is a hash kept in a Storable file in the XDG cache directory,
+# which several runs may share at the same time.  The hash has a 'format'
+# key, so a store written with another layout is ignored rather than misread.
+#   storePath(@names):         the path of the store named by @names, or ''
+#                              if there is no cache directory
+#   storeOpen($path, $format): the data of the store, a hash, or undef if it
+#                              does not exist yet or its 'format' key is not
+#                              $format (a layout version or any other stamp)
+#   storeSave($path, \%data):  write the data to the store atomically, unless
+#                              this is a process forked from the one that
+#                              opened the store, which leaves that to its parent
+#   storeAtExit(\&save):       call &save at the exit of this process
+#==============================================================================
+
+my (%Owners) = ();    # store path => the process that opened the store
+my (@AtExit) = ();    # the code to run at exit
+
+# return the path of the store named by the specified names, under the XDG
+# cache directory, or '' if there is none
+sub storePath
+{
+  my (@names) = @_;
+  my ($cache) = $ENV{'XDG_CACHE_HOME'};
+  $cache = "$ENV{'HOME'}/.cache" if (!$cache && $ENV{'HOME'});
+  return '' if (!$cache);
+  return join('/', "$cache/krazy2", @names);
+}
+
+# return the data of the store in the specified file, if it has the
+# specified format, else undef
+sub storeOpen
+{
+  my ($path, $format) = @_;
+
+  $Owners{$path} = $$;
+  my ($d) = -f $path ? eval {retrieve($path)} : undef;
+  return undef if (!$d || ref($d) ne 'HASH' || !defined($d->{'format'}) || $d->{'format'} ne $format);    ## no critic
+  return $d;
+}
+
+# write the specified data to the store in the specified file, atomically.
+# returns 1 on success (or when another process is to write it), 0 otherwise.
+sub storeSave
+{
+  my ($path, $data) = @_;
+  return 1 if (defined($Owners{$path}) && $Owners{$path} != $$);
+
+  my ($dir) = $path;
+  $dir =~ s+/[^/]*$++;
+  eval {make_path($dir)} if (!-d $dir);
+  my ($fh, $tmp) = eval {tempfile(".store-XXXXXX", DIR => $dir);};
+  return 0 if (!$fh);
+  my ($ok) = eval {nstore_fd($data, $fh)};
+  if (!$ok || !close($fh) || !rename($tmp, $path)) {
+    unlink($tmp);
+    return 0;
+  }
+  return 1;
+}
+
+# run the specified code at the exit of this process, to save a store
+sub storeAtExit
+{
+  my ($code) = @_;
+  push(@AtExit, $code);
+}
+
+END {
+  local ($?);
+  &{$_}() foreach (@AtExit);
+}
+
+1;
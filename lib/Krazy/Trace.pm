@@ -0,0 +1,118 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Trace;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use JSON;
+use Time::HiRes qw(time);
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(traceStart tracing traceSpan traceEvent traceThread traceMerge traceWrite);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# A timeline of a run, written in the Chrome trace event format, which can be
+# loaded into trace viewers like Perfetto (ui.perfetto.dev) or chrome://tracing.
+#
+# Each span is a "complete" event with a start time and a duration, shown on
+# the track of a thread: thread 0 is the main process itself, the other
+# threads are the job pool slots running the checker programs.
+# Timestamps are the wall clock time in microseconds, so the traces of
+# several processes (like krazy2all and the krazy2 it runs) can be merged.
+#
+# Nothing is recorded until traceStart() is called.
+#==============================================================================
+
+my ($Enabled) = 0;
+my (@Events);    # the trace events, as hashes
+
+# start recording trace events for this process, which has the specified name
+sub traceStart
+{
+  my ($name) = @_;
+  $Enabled = 1;
+  push(@Events, {'name' => 'process_name', 'ph' => 'M', 'pid' => $$, 'tid' => 0, 'args' => {'name' => $name}});
+  &traceThread(0, $name);
+}
+
+# returns true if trace events are being recorded
+sub tracing
+{
+  return $Enabled;
+}
+
+# record a span on the main thread that started at the specified time and
+# ends now, with an optional hash of arguments.  returns the current time.
+sub traceSpan
+{
+  my ($name, $start, $args) = @_;
+  my ($now) = time();
+  &traceEvent($name, $start, $now, 0, $args);
+  return $now;
+}
+
+# record a span with the specified start and end times, on the specified thread
+sub traceEvent
+{
+  my ($name, $start, $end, $tid, $args) = @_;
+  return if (!$Enabled);
+
+  my ($event) = {
+    'name' => $name,
+    'ph'   => 'X',
+    'ts'   => int($start * 1e6),
+    'dur'  => int(($end - $start) * 1e6),
+    'pid'  => $$,
+    'tid'  => $tid,
+  };
+  $event->{'args'} = $args if ($args);
+  push(@Events, $event);
+}
+
+# give a name to the specified thread
+sub traceThread
+{
+  my ($tid, $name) = @_;
+  return if (!$Enabled);
+  push(@Events, {'name' => 'thread_name', 'ph' => 'M', 'pid' => $$, 'tid' => $tid, 'args' => {'name' => $name}});
+}
+
+# add the events of the trace file written by another process.
+# returns 1 on success, 0 otherwise.
+sub traceMerge
+{
+  my ($path) = @_;
+
+  open(my $fh, '<', $path) or return 0;
+  my ($text) = do {local $/; <$fh>};
+  close($fh);
+  my ($trace) = eval {decode_json($text)};
+  return 0 if (!$trace || ref($trace->{'traceEvents'}) ne 'ARRAY');
+  push(@Events, @{$trace->{'traceEvents'}});
+  return 1;
+}
+
+# write the trace events to the specified file.
+# returns 1 on success, 0 otherwise.
+sub traceWrite
+{
+  my ($path) = @_;
+
+  open(my $fh, '>', $path) or return 0;
+  print $fh "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  my ($json) = JSON->new->canonical;
+  print $fh join(",\n", map {$json->encode($_)} @Events);
+  print $fh "\n]}\n";
+  return close($fh);
+}
+
+1;
@@ -17,17 +17,22 @@ use File::Glob ':bsd_glob';
 use File::Find;
 use File::Spec::Functions 'catfile';
 use Getopt::Long;
+use Storable qw(retrieve);
+use Krazy::PatternSet;
 
 use Exporter;
 $VERSION = 2.99999;                                            # this is the module version
 @ISA     = qw(Exporter);
 
-@EXPORT = qw(topOfProject
+@EXPORT = qw(topOfProject gitChangedFiles gitChangedLines
   userMessage userError Exit
   fileType validateFileType fileTypeIs findFiles findFileByRegex asOf deDupe addRegEx
   addCommaSeparated commaSeparatedToArray arrayToCommaSeparated
-  parseArgs helpArg versionArg priorityArg strictArg
-  explainArg quietArg verboseArg
+  parseArgs setArgs helpArg versionArg priorityArg strictArg
+  checkSetsArg explainArg quietArg verboseArg batchArg batchFiles runBatch
+  setFileContent fileContent fileLines
+  setDecls declClasses declInherits
+  parseIncludes setIncGraph graphIncludes
   priorityTypeStr strictTypeStr exportTypeStr
   outputTypeStr checksetTypeStr
   cppIncludeOrderTypeStr
@@ -93,6 +98,110 @@ sub topOfProject
   return $top;
 }
 
+# full path to the top of the git work tree holding the specified directory,
+# or '' if the directory is not in a git work tree.
+sub gitTopLevel
+{
+  my ($dir) = @_;
+  $dir = getcwd if (!$dir);
+  my ($out) = &gitOutput('-C', $dir, 'rev-parse', '--show-toplevel');
+  return '' if (!defined($out) || !@{$out});
+  return $out->[0];
+}
+
+# run git with the specified arguments, without a shell and with its error
+# messages discarded.  returns a reference to the list of its output lines,
+# chomped, or undef if git failed.
+sub gitOutput
+{
+  my (@args) = @_;
+
+  my ($pid) = open(my $fh, '-|');
+  return undef if (!defined($pid));    ## no critic
+  if (!$pid) {
+    open(STDERR, '>', '/dev/null');
+    exec('git', @args) or POSIX::_exit(127);
+  }
+  my (@lines) = <$fh>;
+  close($fh);
+  return undef if ($? != 0);           ## no critic
+  chomp(@lines);
+  return \@lines;
+}
+
+# return a reference to the list of the paths, relative to the top of the
+# specified git work tree, of its files not tracked yet and not ignored,
+# or undef if they cannot be determined.
+sub gitUntrackedFiles
+{
+  my ($top) = @_;
+  return &gitOutput('-C', $top, '-c', 'core.quotePath=false', 'ls-files', '--others', '--exclude-standard');
+}
+
+# return a reference to the list of full paths of the files changed in the git
+# work tree holding the specified directory since the specified revision.
+# deleted files are left out, files not tracked yet are included.
+# returns undef if the changes cannot be determined.
+sub gitChangedFiles
+{
+  my ($rev, $dir) = @_;
+  my ($top) = &gitTopLevel($dir);
+  return undef if (!$top || $rev =~ m/^-/);    ## no critic
+
+  my ($files) =
+    &gitOutput('-C', $top, '-c', 'core.quotePath=false', 'diff', '--name-only', '--no-renames', '--diff-filter=d', $rev, '--');
+  return undef if (!defined($files));          ## no critic
+  my ($untracked) = &gitUntrackedFiles($top);
+  return undef if (!defined($untracked));      ## no critic
+  return [map {"$top/$_"} @{$files}, @{$untracked}];
+}
+
+# return a reference to a hash of the lines changed in the git work tree holding
+# the specified directory since the specified revision: the full path of each
+# changed file maps to a hash of the line numbers added or modified in the file.
+# all the lines of the files not tracked yet are changed.
+# returns undef if the changes cannot be determined.
+sub gitChangedLines
+{
+  my ($rev, $dir) = @_;
+  my ($top) = &gitTopLevel($dir);
+  return undef if (!$top || $rev =~ m/^-/);    ## no critic
+
+  my ($diff) = &gitOutput('-C', $top, '-c', 'core.quotePath=false', 'diff', '-U0', '--no-color', '--no-ext-diff',
+    '--no-renames', '--diff-filter=d', $rev, '--');
+  return undef if (!defined($diff));           ## no critic
+  my ($untracked) = &gitUntrackedFiles($top);
+  return undef if (!defined($untracked));      ## no critic
+
+  my (%lines);
+  my ($file)   = '';
+  my ($header) = 0;    # in the header of a file diff, where added lines can't be
+  foreach my ($l) (@{$diff}) {
+    if ($l =~ m/^diff /) {
+      $file   = '';
+      $header = 1;
+    } elsif ($header && $l =~ m{^\+\+\+ (?:b/)?(.*?)\t?$}) {
+      $file = ($1 eq '/dev/null') ? '' : "$top/$1";
+      $lines{$file} = {} if ($file && !exists($lines{$file}));
+    } elsif ($file && $l =~ m/^\@\@ -\S+ \+(\d+)(?:,(\d+))? \@\@/) {
+      $header = 0;
+      my ($start, $count) = ($1, defined($2) ? $2 : 1);
+      for (my $n = $start ; $n < $start + $count ; $n++) {
+        $lines{$file}{$n} = 1;
+      }
+    }
+  }
+  foreach my ($u) (@{$untracked}) {
+    my ($n) = 0;
+    $lines{"$top/$u"} = {};
+    if (open(my $fh, '<', "$top/$u")) {
+      $lines{"$top/$u"}{++$n} = 1 while (<$fh>);
+      close($fh);
+    }
+  }
+  return \%lines;
+}
+
 # Exit a checker with the number of issues
 sub Exit
 {
@@ -466,6 +575,186 @@ sub findFileByRegex
   return 0;
 }
 
+my ($contentFile) = '';    # the file whose content krazy2 handed over in memory
+my ($contentRef);          # a reference to that content
+my ($MMAP_MIN) = 1048576;  # files at least this big are read through mmap
+
+# setFileContent function: hand the content (bytes) of the specified file over
+# to fileContent(), for plugins running inside krazy2 or a forked copy of it.
+sub setFileContent
+{
+  my ($f, $ref) = @_;
+  $contentFile = $f;
+  $contentRef  = $ref;
+}
+
+# fileContent function: return the content (bytes) of the specified file.
+# The content krazy2 already read is used when it was handed over, either in
+# memory (see setFileContent) or as an inherited file descriptor given in the
+# KRAZY_CONTENT_FD environment variable for the file named in KRAZY_CONTENT_FILE.
+# Otherwise, as when a plugin runs stand-alone, the file itself is read
+# (memory-mapped, if it is big).
+sub fileContent
+{
+  my ($f) = @_;
+  return ${$contentRef} if ($contentRef && $contentFile eq $f);
+
+  my ($fh);
+  my ($fd) = $ENV{'KRAZY_CONTENT_FD'};
+  if ( defined($fd)
+    && $fd =~ m/^\d+$/
+    && defined($ENV{'KRAZY_CONTENT_FILE'})
+    && $ENV{'KRAZY_CONTENT_FILE'} eq $f)
+  {
+
+    # reopen the descriptor, so readers running at the same time do not share a file offset
+    if (!open($fh, '<:raw', "/proc/self/fd/$fd")) {
+      $fh = undef;
+      if (open($fh, '<&=', $fd)) {
+        binmode($fh);
+        sysseek($fh, 0, 0);
+      } else {
+        $fh = undef;
+      }
+    }
+  }
+  if (!$fh) {
+    my ($size) = -s $f;
+    $fh = undef if (!defined($size) || $size < $MMAP_MIN || !open($fh, '<:mmap', $f));
+  }
+  if (!$fh) {
+    open($fh, '<:raw', $f) or die "Can't open \"$f\": $!\n";
+  }
+  local $/;
+  my ($content) = <$fh>;
+  close($fh);
+  return defined($content) ? $content : "";
+}
+
+# fileLines function: return the lines of the specified file, decoded through
+# the specified PerlIO layer (default is ':encoding(UTF-8)'), just like reading
+# the lines from the file opened with that layer would.
+sub fileLines
+{
+  my ($f, $layer) = @_;
+  $layer = ':encoding(UTF-8)' if (!$layer);
+
+  my ($content) = &fileContent($f);
+  open my $fh, "<$layer", \$content or die "Can't decode \"$f\": $!\n";
+  my (@lines) = <$fh>;
+  close($fh);
+  return @lines;
+}
+
+my ($decls);    # the declaration database, once loaded
+
+# setDecls function: hand the declaration database (see Krazy::Decls) over to
+# declClasses(), for plugins running inside krazy2 or a forked copy of it.
+sub setDecls
+{
+  my ($d) = @_;
+  $decls = $d;
+}
+
+# declClasses function: return the records of the classes of the specified
+# name declared in the headers of the project (see Krazy::Decls), from the
+# database krazy2 built: handed over in memory (see setDecls), or in the file
+# named in the KRAZY_DECLS environment variable.  There are none when there
+# is no database, as when a plugin runs stand-alone.
+sub declClasses
+{
+  my ($name) = @_;
+
+  if (!defined($decls)) {
+    $decls = {};
+    my ($path) = $ENV{'KRAZY_DECLS'};
+    if ($path && -f $path) {
+      my ($d) = eval {retrieve($path)};
+      $decls = $d if ($d && ref($d) eq 'HASH');
+    }
+  }
+  $name =~ s/^.*:://;
+  return () if (!$decls->{'classes'} || !$decls->{'classes'}{$name});
+  return @{$decls->{'classes'}{$name}};
+}
+
+# declInherits function: return true if a class of the specified name has the
+# specified base class, directly or through the classes of the project
+sub declInherits
+{
+  my ($name, $base, $seen) = @_;
+  $seen = {} if (!$seen);
+
+  $name =~ s/^.*:://;
+  return 0 if ($seen->{$name}++);
+  foreach my ($c) (&declClasses($name)) {
+    foreach my ($b) (@{$c->{'bases'}}) {
+      return 1 if ($b eq $base || &declInherits($b, $base, $seen));
+    }
+  }
+  return 0;
+}
+
+# parseIncludes function: return the #include directives of the specified
+# C/C++ lines (without C-style comments), as {line, path, sep} hashes: the
+# line number, the path included and the separator ('"', '<' or '' for an
+# include of a macro, whose name is the path).
+sub parseIncludes
+{
+  my (@lines) = @_;
+  my (@incs) = ();
+  for (my $i = 0 ; $i <= $#lines ; $i++) {
+    next if ($lines[$i] !~ m/^[[:space:]]*#[[:space:]]*include[[:space:]]*(.*)$/);
+    my ($rest) = $1;
+    if ($rest =~ m/^"([^"]*)/) {
+      push(@incs, {'line' => $i + 1, 'path' => $1, 'sep' => '"'});
+    } elsif ($rest =~ m/^<([^>]*)/) {
+      push(@incs, {'line' => $i + 1, 'path' => $1, 'sep' => '<'});
+    } else {
+      $rest =~ s+//.*++;
+      $rest =~ s/[[:space:]]+$//;
+      push(@incs, {'line' => $i + 1, 'path' => $rest, 'sep' => ''});
+    }
+  }
+  return @incs;
+}
+
+my ($incgraph);    # the include graph, once loaded
+
+# setIncGraph function: hand the include graph (see Krazy::IncGraph) over to
+# graphIncludes(), for plugins running inside krazy2 or a forked copy of it.
+sub setIncGraph
+{
+  my ($g) = @_;
+  $incgraph = $g;
+}
+
+# graphIncludes function: return a reference to the list of the #include
+# directives of the file of the specified absolute path, as parseIncludes()
+# returns them with the absolute path of the project file each one resolves
+# to added as 'target' ('' if none), from the include graph krazy2 built:
+# handed over in memory (see setIncGraph), or in the file named in the
+# KRAZY_INCGRAPH environment variable.  Returns undef when the file is not in
+# the graph, or there is no graph, as when a plugin runs stand-alone.
+sub graphIncludes
+{
+  my ($absf) = @_;
+
+  if (!defined($incgraph)) {
+    $incgraph = {};
+    my ($path) = $ENV{'KRAZY_INCGRAPH'};
+    if ($path && -f $path) {
+      my ($g) = eval {retrieve($path)};
+      $incgraph = $g if ($g && ref($g) eq 'HASH');
+    }
+  }
+  return undef if (!defined($absf) || !$incgraph->{'files'} || !$incgraph->{'files'}{$absf});    ## no critic
+
+  my ($incs)    = $incgraph->{'files'}{$absf}{'includes'};
+  my ($targets) = $incgraph->{'metrics'}{'targets'}{$absf} || [];
+  return [map {+{%{$incs->[$_]}, 'target' => $targets->[$_] || ''}} 0 .. $#{$incs}];
+}
+
 # asOf function: return nicely formatted string containing the current time
 sub asOf
 {
@@ -485,6 +774,7 @@ my ($checksets) = '';
 my ($explain)   = '';
 my ($quiet)     = '';
 my ($verbose)   = '';
+my ($batch)     = '';
 
 sub parseArgs
 {
@@ -500,7 +790,8 @@ sub parseArgs
       'check-sets=s' => \$checksets,
       'explain'      => \$explain,
       'verbose'      => \$verbose,
-      'quiet'        => \$quiet
+      'quiet'        => \$quiet,
+      'batch'        => \$batch
     )
     );
 
@@ -532,13 +823,63 @@ sub parseArgs
 
 }
 
-sub helpArg     {return $help;}
-sub versionArg  {return $version;}
-sub priorityArg {return $priority;}
-sub strictArg   {return $strict;}
-sub explainArg  {return $explain;}
-sub quietArg    {return $quiet;}
-sub verboseArg  {return $verbose;}
+# set the plugin arguments directly, for plugins running inside krazy2
+sub setArgs
+{
+  my (%args) = @_;
+
+  $krazy     = 1;
+  $priority  = $args{'priority'}  if (defined($args{'priority'}));
+  $strict    = $args{'strict'}    if (defined($args{'strict'}));
+  $checksets = $args{'checksets'} if (defined($args{'checksets'}));
+  $quiet     = $args{'quiet'}     if (defined($args{'quiet'}));
+  $verbose   = $args{'verbose'}   if (defined($args{'verbose'}));
+}
+
+sub helpArg      {return $help;}
+sub versionArg   {return $version;}
+sub priorityArg  {return $priority;}
+sub strictArg    {return $strict;}
+sub checkSetsArg {return $checksets;}
+sub explainArg   {return $explain;}
+sub quietArg     {return $quiet;}
+sub verboseArg   {return $verbose;}
+sub batchArg     {return $batch;}
+
+# batchFiles function: return the list of files to check in batch mode,
+# read from stdin as a NUL or newline separated list.
+sub batchFiles
+{
+  local $/;
+  my ($list) = <STDIN>;
+  return () if (!defined($list));
+
+  my ($sep) = ($list =~ m/\0/) ? "\0" : "\n";
+  return grep {$_ ne ""} split(/$sep/, $list);
+}
+
+# runBatch function: check each file listed on stdin and exit.
+# $check is a reference to the function checking a single file; it must
+# print the output for the file and return the number of issues found.
+# Each file gets a result record on stdout, holding the line FILE=<file>,
+# the output of the check and finally the line ISSUES=<number of issues>.
+# The record of a file that fails to check is left without its ISSUES line.
+sub runBatch
+{
+  my ($check) = @_;
+
+  foreach my ($f) (&batchFiles()) {
+    print "FILE=$f\n";
+    my ($issues) = eval {$check->($f);};
+    if ($@) {
+      print STDERR $@;
+      next;
+    }
+    $issues = 0 if (!defined($issues));
+    print "ISSUES=$issues\n";
+  }
+  exit 0;
+}
 
 sub exportTypeStr
 {
@@ -743,15 +1084,14 @@ sub linesSearchInFile
   my ($f, @lines) = @_;
 
   open my $fh, '<:encoding(UTF-8)', $f or return -1;
+  my ($set) = Krazy::PatternSet->new([@lines]);
   my ($cnt) = 0;
   while (<$fh>) {
     $cnt++;
     chomp($_);
-    for my ($l) (@lines) {
-      if ($_ =~ m/$l/) {
-        close($fh);
-        return $cnt;
-      }
+    if ($set->test($_)) {
+      close($fh);
+      return $cnt;
     }
   }
   close($fh);
@@ -769,15 +1109,14 @@ sub linesCaseSearchInFile
   my ($f, @lines) = @_;
 
   open my $fh, '<:encoding(UTF-8)', $f or return -1;
+  my ($set) = Krazy::PatternSet->new([@lines], 'icase' => 1);
   my ($cnt) = 0;
   while (<$fh>) {
     $cnt++;
     chomp($_);
-    for my ($l) (@lines) {
-      if ($_ =~ m/$l/i) {
-        close($fh);
-        return $cnt;
-      }
+    if ($set->test($_)) {
+      close($fh);
+      return $cnt;
     }
   }
   close($fh);
@@ -855,7 +1194,7 @@ sub guessCheckSet
       $checkset = "qt";
     } elsif (&allLinesCaseSearchInFile($cmakepath, ("project\\s*\\(.*CXX")) > 0) {
       $checkset = "c++";
-    } elsif (&allLinesCaseSearchInFile($cmakepath, ("enable_language\\s*\\((\\s*CXX")) > 0) {
+    } elsif (&allLinesCaseSearchInFile($cmakepath, ("enable_language\\s*\\(\\s*CXX")) > 0) {
       $checkset = "c++";
     }
   } elsif (-e $qmakepath) {
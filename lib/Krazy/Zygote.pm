@@ -0,0 +1,122 @@
+###############################################################################
+# Sanity checks for your source code                                          #
+# SPDX-FileCopyrightText: 2026 Allen Winter <winter@kde.org>                  #
+# SPDX-License-Identifier: GPL-2.0-or-later                                   #
+###############################################################################
+
+package Krazy::Zygote;
+
+use warnings;
+use strict;
+use vars qw(@ISA @EXPORT @EXPORT_OK %EXPORT_TAGS $VERSION);    ## no critic
+use POSIX ();
+use Time::HiRes qw(time);
+
+# the modules most checker programs use, loaded once before forking
+use Getopt::Long;
+use File::Find;
+use FindBin;
+use JSON;
+use Tie::IxHash;
+use Krazy::Config;
+use Krazy::PreProcess;
+use Krazy::Utils;
+
+use Exporter;
+$VERSION = 1.00;
+@ISA     = qw(Exporter);
+
+@EXPORT    = qw(isPerlChecker runChecker measureStartup);
+@EXPORT_OK = qw();
+
+#==============================================================================
+# Run Perl checker programs in forked copies of the current process.
+#
+# The process using this module acts as a "zygote": the perl interpreter and
+# the modules the checker programs commonly use are already loaded, so a
+# forked child only needs to compile the checker script itself, sharing
+# everything else with its parent copy-on-write.
+#
+# runChecker() must be called in a forked child process.  It runs the
+# checker program as if it had been started with the specified arguments,
+# with its output going to stdout, and never returns.
+#==============================================================================
+
+# returns 1 if the specified checker program is a Perl script
+sub isPerlChecker
+{
+  my ($p) = @_;
+
+  open my $fh, '<', $p or return 0;
+  my ($line) = <$fh>;
+  close($fh);
+  return (defined($line) && $line =~ m/^#!.*\bperl\b/);
+}
+
+# run the checker program in this (forked) process and exit with its status
+sub runChecker
+{
+  my ($p, @args) = @_;
+
+  # what running the program with "#!/usr/bin/perl -w" would give
+  open my $fh, '<', $p;
+  my ($shebang) = $fh ? <$fh> : "";
+  close($fh) if ($fh);
+  $^W = ($shebang =~ m/^#!\S*perl\S*\s+-\w*w/) ? 1 : 0;    ## no critic
+
+  @ARGV = @args;
+  $0    = $p;
+  FindBin::again();
+
+  # remember the exit status perl would use if the program dies
+  my ($diestatus) = 255;
+  local $SIG{__DIE__} = sub {
+    $diestatus = $! ? $! + 0 : ($? >> 8) ? ($? >> 8) : 255;
+  };
+
+  # the checker program normally ends by calling exit itself.  It is compiled
+  # in a package of its own, so its subs do not redefine those of krazy2.
+  my ($status) = 0;
+  {
+
+    package Krazy::Zygote::Checker;
+    do $p;
+  }
+  $status = $diestatus if ($@);
+  STDOUT->flush();
+  POSIX::_exit($status);
+}
+
+# measure the average startup time of the checker program, in seconds,
+# when started as a new program and when run by the zygote.
+sub measureStartup
+{
+  my ($p, $runs) = @_;
+  my ($t, $fh);
+
+  $t = time();
+  for (my $i = 0 ; $i < $runs ; $i++) {
+    if (open($fh, "$p --version 2>/dev/null |")) {    ## no critic
+      my (@out) = <$fh>;
+      close($fh);
+    }
+  }
+  my ($exectime) = (time() - $t) / $runs;
+
+  $t = time();
+  for (my $i = 0 ; $i < $runs ; $i++) {
+    my ($pid) = open($fh, "-|");
+    next if (!defined($pid));
+    if ($pid == 0) {
+      open(STDERR, '>', '/dev/null');
+      &runChecker($p, "--version");
+    }
+    my (@out) = <$fh>;
+    close($fh);
+  }
+  my ($forktime) = (time() - $t) / $runs;
+
+  return ($exectime, $forktime);
+}
+
+1;
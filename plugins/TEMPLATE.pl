@@ -19,76 +19,90 @@ eval 'exec /usr/bin/perl -w -S $0 ${1+"$@"}'
 #   --explain:       print an explanation with solving instructions
 #   --quiet:         suppress all output messages
 #   --verbose:       print the offending content
+#   --batch:         check each file listed on stdin, printing a result record per file
 
 # Exits with status=0 if test condition is not present in the source;
 # else exits with the number of failures encountered.
 
+# This plugin uses the Krazy::Plugin API, so krazy2 may load it once and
+# call check() for each file instead of running it as a program every time;
+# when it does run as a program, the API also takes care of the --batch option.
+# krazy-meta: api=plugin
+
+# Declare the files the plugin applies to, so krazy2 doesn't run it for the
+# others (see pluginFilter() in Krazy::Plugin); a plugin for C++ sources only
+# would have the line "# krazy-meta: files=!header,!c".  A plugin that can only
+# find issues in files holding certain strings may list them, as in
+# "# krazy-meta: triggers=SIGNAL,SLOT", to be skipped for the other files.
+
+# use a package name unique to this plugin, eg. Krazy::Plugin::<filetype>::<plugin>
+package Krazy::Plugin::TEMPLATE;
+
 use warnings;
 use strict;
 use FindBin qw($Bin);
 use lib "$Bin/../../../../lib";
 use Krazy::PreProcess;
+use Krazy::Source;
 use Krazy::Utils;
+use parent 'Krazy::Plugin';
 
 my ($Prog)    = "<plugin>";
 my ($Version) = "<version>";
 
-&parseArgs();
-
-&Help()    if &helpArg();
-&Version() if &versionArg();
-&Explain() if &explainArg();
-if ($#ARGV != 0) {&Help(); Exit 0;}
-
-my ($f) = $ARGV[0];
-
-# open file and slurp it in
-open my $fh, '<:encoding(UTF-8)', $f or die;
-my (@data_lines) = <$fh>;
-close($fh);
-
-# possibly post-process each line (remove-comments, etc)
-# @lines = &postProcess(@data_lines)
-
-# Check Condition
-#my($linecnt) = 0;
-#my($lstr) = "";
-#foreach my ($line) (@lines) {
-#  $linecnt++;
-#  if ($line =~ m/SOMETHING/) {
-#    $cnt++;
-#    if ($cnt == 1) {
-#      $lstr = "line\#" . $linecnt;
-#    } else {
-#      $lstr = $lstr . "," . $linecnt;
-#    }
-#    print "=> $line\n" if (&verboseArg());
-#  }
-#}
+sub name    {return $Prog;}
+sub version {return $Version;}
 
-# Handle Check Results
-#if (!$cnt) {
-#  print "okay\n" if (!&quietArg());
-#  Exit 0;
-#} else {
-#  print "$lstr ($cnt)\n" if (!&quietArg());
-#  Exit $cnt;
-#}
-
-sub Help
+sub help
 {
-  print "Check for <condition>\n";
-  Exit 0 if &helpArg();
+  return "Check for <condition>";
 }
 
-sub Version
+sub explain
 {
-  print "$Prog, version $Version\n";
-  Exit 0 if &versionArg();
+  return "<describe problem with solution.>";
 }
 
-sub Explain
+# optional one-time set-up, called when krazy2 loads the plugin
+#sub prepare
+#{
+#  my ($self) = @_;
+#}
+
+# check the file, returning the number of issues followed by the output lines
+sub check
 {
-  print "<describe problem with solution.>\n";
-  Exit 0 if &explainArg();
+  my ($self, $f, $ctx) = @_;
+
+  # open file and slurp it in
+  my (@data_lines) = &fileLines($f);
+
+  # possibly post-process each line (remove-comments, etc); for C++ the
+  # forms made by Krazy::Source are shared with the other checkers, eg.
+  # my (@lines) = Krazy::Source->forFile($f)->noCondLines($Prog);
+
+  # Check Condition
+  my ($cnt) = 0;
+  my (@out) = ();
+
+  #my($linecnt) = 0;
+  #my($lstr) = "";
+  #foreach my ($line) (@lines) {
+  #  $linecnt++;
+  #  if ($line =~ m/SOMETHING/) {
+  #    $cnt++;
+  #    if ($cnt == 1) {
+  #      $lstr = "line\#" . $linecnt;
+  #    } else {
+  #      $lstr = $lstr . "," . $linecnt;
+  #    }
+  #    push(@out, "=> $line") if ($ctx->{'verbose'});
+  #  }
+  #}
+  #push(@out, "$lstr ($cnt)") if ($cnt);
+
+  # Handle Check Results ("okay" is printed for you if there are no issues)
+  return ($cnt, @out);
 }
+
+__PACKAGE__->run();
@@ -10,7 +10,7 @@ CHECKSTMP="$(mktemp)"
 NODATA="$(mktemp)"
 NOTEST="$(mktemp)"
 
-find . -mindepth 3 -type d | sort > "$TESTSTMP"
+find . -mindepth 3 -maxdepth 3 -type d | sort > "$TESTSTMP"
 
 cd ..
 find ./plugins/ -mindepth 2 -type f ! -name Makefile ! -name description.txt > "$PLUGINSTMP"
@@ -0,0 +1,19 @@
+class FOO_EXPORT Foo1 { //the first line of the file holds a class too
+public:
+    Foo1();
+};
+
+class FooPrivate { //ok, not exported
+};
+
+template<typename T>
+class FOO_EXPORT FooList { //ok, a template
+};
+
+class FOO_EXPORT Foo2 { //multiclasses
+public:
+    Foo2();
+};
+
+class FOO_EXPORT Foo3 { //krazy:exclude=multiclasses
+};
@@ -0,0 +1,14 @@
+/* Comment markers in string literals and in C++ comments do not start C comments */
+void ParentWidget::slotAsk() {
+    const QString open = QStringLiteral("/*"); //not a comment start
+    SomeDialog dlg( this ); //the dlg-on-stack-variant
+    if ( dlg.exec() == QDialog::Accepted ) {
+    }
+}
+
+// a C comment ends with */ and starts with /*
+void ParentWidget::slotTell() {
+    SomeDialog dlg( this ); //the dlg-on-stack-variant
+    if ( dlg.exec() == QDialog::Accepted ) {
+    }
+} /* both dialogs are on the stack */
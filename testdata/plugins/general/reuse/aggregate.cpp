@@ -0,0 +1,12 @@
+//The license of the REUSE.toml annotation is added, and missing from LICENSES
+// SPDX-FileCopyrightText: 2024 John Doe <john@example.org>
+// SPDX-License-Identifier: MIT
+//This file is longer than 8 lines
+
+#include <iostream>
+
+int main(int argc, char ** argv)
+{
+	std::cout << "Hello World\n";
+	return 0;
+}
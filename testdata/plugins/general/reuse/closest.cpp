@@ -0,0 +1,12 @@
+//The lines of the file win over its REUSE.toml annotation
+// SPDX-FileCopyrightText: 2024 John Doe <john@example.org>
+// SPDX-License-Identifier: GPL-2.0-or-later
+//This file is longer than 8 lines
+
+#include <iostream>
+
+int main(int argc, char ** argv)
+{
+	std::cout << "Hello World\n";
+	return 0;
+}
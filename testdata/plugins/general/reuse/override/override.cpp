@@ -0,0 +1,12 @@
+//The REUSE.toml annotation overrides the lines of the file
+// SPDX-FileCopyrightText: 2024 John Doe
+// SPDX-License-Identifier: LGPL-2.0-or-later
+//This file is longer than 8 lines
+
+#include <iostream>
+
+int main(int argc, char ** argv)
+{
+	std::cout << "Hello World\n";
+	return 0;
+}
@@ -0,0 +1,10 @@
+//The SPDX lines are given by sidecar.cpp.license
+//This file is longer than 8 lines
+
+#include <iostream>
+
+int main(int argc, char ** argv)
+{
+	std::cout << "Hello World\n";
+	return 0;
+}